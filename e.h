@@ -353,7 +353,8 @@ E_API void  e_free(void* p, const e_allocation_callbacks* pAllocationCallbacks);
 
 
 /* BEG e_misc.h */
-E_API void e_sort(void* pList, size_t count, size_t stride, int (*compareProc)(void*, const void*, const void*), void* pUserData);
+E_API void e_sort(void* pList, size_t count, size_t stride, int (*compareProc)(void*, const void*, const void*), void* pUserData);   /* Stable. Same as e_sort_ex() with the default allocator. */
+E_API void e_sort_ex(void* pList, size_t count, size_t stride, int (*compareProc)(void*, const void*, const void*), void* pUserData, const e_allocation_callbacks* pAllocationCallbacks);  /* Stable. Uses a temporary buffer of count * stride bytes. If it can't be allocated the list is sorted in place, which is slower. */
 
 E_API void* e_binary_search(const void* pKey, const void* pList, size_t count, size_t stride, int (*compareProc)(void*, const void*, const void*), void* pUserData);
 E_API void* e_linear_search(const void* pKey, const void* pList, size_t count, size_t stride, int (*compareProc)(void*, const void*, const void*), void* pUserData);
@@ -769,6 +770,7 @@ struct e_stream_vtable
     size_t   (* duplicate_alloc_size)(e_stream* pStream);                                 /* Optional. Returns the allocation size of the stream. When not defined, duplicating is disabled. */
     e_result (* duplicate           )(e_stream* pStream, e_stream* pDuplicatedStream);    /* Optional. Duplicate the stream. */
     void     (* uninit              )(e_stream* pStream);                                 /* Optional. Uninitialize the stream. */
+    e_result (* read_at             )(e_stream* pStream, e_uint64 offset, void* pDst, size_t bytesToRead, size_t* pBytesRead);  /* Optional. Read from an absolute offset without using or moving the cursor. Must be safe to call from multiple threads at once. */
 };
 
 struct e_stream
@@ -786,6 +788,15 @@ E_API e_result e_stream_writef_ex(e_stream* pStream, const e_allocation_callback
 E_API e_result e_stream_writefv(e_stream* pStream, const char* fmt, va_list args);
 E_API e_result e_stream_writefv_ex(e_stream* pStream, const e_allocation_callbacks* pAllocationCallbacks, const char* fmt, va_list args);
 
+/*
+Reads from an absolute offset without using or moving the cursor of the stream.
+
+This is optional for streams and will return E_NOT_IMPLEMENTED if it's not supported, in which case
+use e_stream_seek() and e_stream_read() instead. When it is supported it can be called from multiple
+threads at the same time. Like e_stream_read(), E_AT_END is only returned if nothing could be read.
+*/
+E_API e_result e_stream_read_at(e_stream* pStream, e_uint64 offset, void* pDst, size_t bytesToRead, size_t* pBytesRead);
+
 /*
 Duplicates a stream.
 
@@ -884,9 +895,39 @@ There is only one cursor. As you read and write the cursor will move forward. If
 read and write from different locations from the same e_memory_stream object, you need to
 seek before doing your read or write. You cannot read and write at the same time across
 multiple threads for the same e_memory_stream object.
+
+
+Write mode stores everything in a single buffer. When it needs to grow, the entire buffer is
+reallocated and copied. This is fine for small streams, but for large streams, such as big save
+files, the copies get expensive and peak memory usage can reach twice the size of the data. For
+these cases you can use chunked mode with e_memory_stream_init_write_chunked(). In chunked mode,
+the data is stored in a list of fixed-size chunks. Growing the stream only allocates new chunks,
+and removing data only moves memory within the affected chunks.
+
+In chunked mode the `write.pData` member is always null. To access the data you can iterate over
+the chunks. This is useful for vectored writes:
+
+    ```c
+    size_t chunkCount;
+    const e_memory_stream_chunk* pChunks = e_memory_stream_get_chunks(&stream, &chunkCount);
+
+    for (iChunk = 0; iChunk < chunkCount; iChunk += 1) {
+        e_file_write(pFile, pChunks[iChunk].pData, pChunks[iChunk].size, NULL);
+    }
+    ```
+
+A chunk will not necessarily be full. Chunks are only flattened into a single buffer when
+e_memory_stream_take_ownership() is called.
 */
 typedef struct e_memory_stream e_memory_stream;
 
+typedef struct e_memory_stream_chunk
+{
+    void* pData;
+    size_t offset;      /* The offset of the first byte of this chunk, relative to the start of the stream. */
+    size_t size;        /* The number of bytes in this chunk that are in use. */
+} e_memory_stream_chunk;
+
 struct e_memory_stream
 {
     e_stream base;
@@ -903,11 +944,19 @@ struct e_memory_stream
         size_t dataSize;
         size_t dataCap;
     } write;
+    struct
+    {
+        e_memory_stream_chunk* pChunks; /* Will only be set in chunked mode. */
+        size_t chunkCount;
+        size_t chunkCap;
+        size_t chunkSize;               /* Will be non-zero in chunked mode. */
+    } chunked;
     size_t cursor;
     e_allocation_callbacks allocationCallbacks; /* This is copied from the allocation callbacks passed in from e_memory_stream_init(). Only used in write mode. */
 };
 
 E_API e_result e_memory_stream_init_write(const e_allocation_callbacks* pAllocationCallbacks, e_memory_stream* pStream);
+E_API e_result e_memory_stream_init_write_chunked(size_t chunkSize, const e_allocation_callbacks* pAllocationCallbacks, e_memory_stream* pStream);   /* Set chunkSize to 0 to use the default. */
 E_API e_result e_memory_stream_init_readonly(const void* pData, size_t dataSize, e_memory_stream* pStream);
 E_API void e_memory_stream_uninit(e_memory_stream* pStream);    /* Only needed for write mode. This will free the internal pointer so make sure you've done what you need to do with it. */
 E_API e_result e_memory_stream_read(e_memory_stream* pStream, void* pDst, size_t bytesToRead, size_t* pBytesRead);
@@ -916,9 +965,153 @@ E_API e_result e_memory_stream_seek(e_memory_stream* pStream, e_int64 offset, in
 E_API e_result e_memory_stream_tell(e_memory_stream* pStream, size_t* pCursor);
 E_API e_result e_memory_stream_remove(e_memory_stream* pStream, size_t offset, size_t size);
 E_API e_result e_memory_stream_truncate(e_memory_stream* pStream);
-E_API void* e_memory_stream_take_ownership(e_memory_stream* pStream, size_t* pSize);  /* Takes ownership of the buffer. The caller is responsible for freeing the buffer with e_free(). Only valid in write mode. */
+E_API void* e_memory_stream_take_ownership(e_memory_stream* pStream, size_t* pSize);  /* Takes ownership of the buffer. The caller is responsible for freeing the buffer with e_free(). Only valid in write mode. In chunked mode this will flatten the chunks into a newly allocated buffer, and will return null if the allocation fails. */
+E_API const e_memory_stream_chunk* e_memory_stream_get_chunks(e_memory_stream* pStream, size_t* pChunkCount);  /* Only valid in chunked mode. The returned pointer is invalidated by writes and removals. */
 /* END e_memory_stream.h */
 
+/* BEG e_pipe_stream.h */
+/*
+A pipe stream is a fixed capacity ring buffer which allows one thread to write data into the stream
+while another thread reads it out. This is useful for chaining stages of a pipeline across threads
+without needing to have the entire contents in memory at once. For example, a decompression thread
+can feed a parser thread.
+
+    ```c
+    e_pipe_stream pipe;
+    e_pipe_stream_init(65536, NULL, &pipe);
+
+    // Producer thread.
+    e_stream_write(&pipe.base, pData, dataSize, NULL);
+    e_pipe_stream_close_write(&pipe);  // Signals the end of the stream to the reader.
+
+    // Consumer thread.
+    e_stream_read(&pipe.base, pBuffer, sizeof(pBuffer), &bytesRead);
+    ```
+
+Only a single reader and a single writer is supported. Seeking is not supported.
+
+By default reading and writing will block. A read will block until the requested number of bytes
+have been read, or until the write end has been closed. Likewise, a write will block until every
+byte has been written, or until the read end has been closed. When the write end has been closed
+and all data has been read, reads will return E_AT_END. When the read end has been closed, writes
+will return E_BAD_PIPE.
+
+A timeout can be set for each end with `e_pipe_stream_set_read_timeout()` and
+`e_pipe_stream_set_write_timeout()`. Use E_PIPE_STREAM_INFINITE to block forever (the default), or 0
+for non-blocking mode. In non-blocking mode, only what can be done immediately is done. If nothing
+could be read, E_NO_DATA_AVAILABLE is returned. If nothing could be written, E_BUSY is returned. In
+timed mode, whatever was transferred before the timeout expired is output, and if nothing was
+transferred, E_TIMEOUT is returned. The timeouts should be set before the stream is shared between
+threads.
+
+Uninitialize the pipe with `e_pipe_stream_uninit()` only after both threads are done with it.
+*/
+#define E_PIPE_STREAM_INFINITE  0xFFFFFFFF
+
+typedef struct e_pipe_stream e_pipe_stream;
+
+struct e_pipe_stream
+{
+    e_stream base;
+    void* pBuffer;
+    size_t capacity;
+    size_t readCursor;          /* Only modified by the reader. Wraps around. Use `% capacity` to get the position in the buffer. */
+    size_t writeCursor;         /* Only modified by the writer. Wraps around. Use `% capacity` to get the position in the buffer. */
+    e_uint32 readTimeoutInMilliseconds;
+    e_uint32 writeTimeoutInMilliseconds;
+    e_bool32 isReadClosed;
+    e_bool32 isWriteClosed;
+    e_bool32 isReaderWaiting;
+    e_bool32 isWriterWaiting;
+    e_mutex lock;               /* Only held while updating cursors and flags. Data is copied with the lock released. */
+    e_semaphore readSemaphore;  /* Posted when data becomes available for a waiting reader. */
+    e_semaphore writeSemaphore; /* Posted when space becomes available for a waiting writer. */
+    e_allocation_callbacks allocationCallbacks;
+};
+
+E_API e_result e_pipe_stream_init(size_t capacity, const e_allocation_callbacks* pAllocationCallbacks, e_pipe_stream* pStream);
+E_API void e_pipe_stream_uninit(e_pipe_stream* pStream);
+E_API e_result e_pipe_stream_read(e_pipe_stream* pStream, void* pDst, size_t bytesToRead, size_t* pBytesRead);
+E_API e_result e_pipe_stream_write(e_pipe_stream* pStream, const void* pSrc, size_t bytesToWrite, size_t* pBytesWritten);
+E_API void e_pipe_stream_set_read_timeout(e_pipe_stream* pStream, e_uint32 timeoutInMilliseconds);
+E_API void e_pipe_stream_set_write_timeout(e_pipe_stream* pStream, e_uint32 timeoutInMilliseconds);
+E_API void e_pipe_stream_close_write(e_pipe_stream* pStream);   /* Called by the writer to signal the end of the stream. */
+E_API void e_pipe_stream_close_read(e_pipe_stream* pStream);    /* Called by the reader to signal that it's no longer interested in data. Unblocks the writer. */
+E_API size_t e_pipe_stream_get_available_bytes(e_pipe_stream* pStream);    /* The number of bytes that can be read without blocking. */
+/* END e_pipe_stream.h */
+
+/* BEG e_hash.h */
+/*
+Checksums and non-cryptographic hashing.
+
+e_crc32() is the standard CRC-32 used by Zip, gzip and PNG. To calculate the checksum of data that
+is delivered in pieces, pass the result of the previous call back in as the first parameter. The
+initial value should be 0:
+
+    ```c
+    e_uint32 crc = 0;
+    crc = e_crc32(crc, pChunk1, chunk1Size);
+    crc = e_crc32(crc, pChunk2, chunk2Size);
+    ```
+
+e_hash64() is a fast 64-bit hash for use with lookup structures and for detecting accidental data
+corruption. It is not suitable for cryptographic purposes. It is based on wyhash. For data that is
+delivered in pieces, use e_hash64_init(), e_hash64_update() and e_hash64_finalize(). The result is
+the same as calling e_hash64() on the whole buffer.
+
+The hash stream is an `e_stream` which wraps another stream and hashes all data that is read from or
+written to it. Data is hashed in the order it passes through the stream, so if you seek, the result
+will not represent the underlying data. Use the flags to choose which hashes to calculate.
+
+    ```c
+    e_hash_stream hashStream;
+    e_hash_stream_init(pSourceStream, E_HASH_STREAM_CRC32, &hashStream);
+
+    // Read from hashStream as you would any other stream...
+
+    if (e_hash_stream_get_crc32(&hashStream) != expectedCRC) {
+        // Corrupt.
+    }
+    ```
+*/
+E_API e_uint32 e_crc32(e_uint32 crc, const void* pData, size_t dataSize);
+
+
+typedef struct e_hash64_state
+{
+    e_uint64 seed;
+    e_uint64 see1;
+    e_uint64 see2;
+    e_uint64 totalSize;
+    e_uint8 pending[48];
+    e_uint8 history[16];        /* The last 16 bytes of the most recently processed block. Needed because the tail is read with an overlap. */
+    size_t pendingSize;
+} e_hash64_state;
+
+E_API e_uint64 e_hash64(const void* pData, size_t dataSize, e_uint64 seed);
+E_API void e_hash64_init(e_hash64_state* pState, e_uint64 seed);
+E_API void e_hash64_update(e_hash64_state* pState, const void* pData, size_t dataSize);
+E_API e_uint64 e_hash64_finalize(const e_hash64_state* pState);   /* Does not modify the state so more data can be added afterwards. */
+
+
+#define E_HASH_STREAM_CRC32     0x01
+#define E_HASH_STREAM_HASH64    0x02
+
+typedef struct e_hash_stream
+{
+    e_stream base;
+    e_stream* pUnderlyingStream;
+    unsigned int flags;
+    e_uint32 crc32;
+    e_hash64_state hash64;
+} e_hash_stream;
+
+E_API e_result e_hash_stream_init(e_stream* pUnderlyingStream, unsigned int flags, e_hash_stream* pStream);   /* Pass 0 for flags to calculate every hash. The underlying stream is not owned by the hash stream. */
+E_API e_uint32 e_hash_stream_get_crc32(const e_hash_stream* pStream);
+E_API e_uint64 e_hash_stream_get_hash64(const e_hash_stream* pStream);
+E_API void e_hash_stream_reset(e_hash_stream* pStream);   /* Resets the hashes without affecting the underlying stream. */
+/* END e_hash.h */
+
 
 #define E_NO_ABOVE_ROOT_NAVIGATION 0x0400   /* <-- Temporary until we get the file system API amalgamated. TODO: Delete this. */
 
@@ -977,7 +1170,10 @@ enum
     E_DEFLATE_FLAG_PARSE_ZLIB_HEADER = 1,
     E_DEFLATE_FLAG_HAS_MORE_INPUT = 2,
     E_DEFLATE_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
-    E_DEFLATE_FLAG_COMPUTE_ADLER32 = 8
+    E_DEFLATE_FLAG_COMPUTE_ADLER32 = 8,
+    E_DEFLATE_FLAG_WRITE_ZLIB_HEADER = 16,      /* Compression only. Wraps the output in a zlib header and trailer. */
+    E_DEFLATE_FLAG_WRITE_GZIP_HEADER = 32,      /* Compression only. Wraps the output in a gzip header and trailer. */
+    E_DEFLATE_FLAG_FLUSH = 64                   /* Compression only. Writes out everything compressed so far and aligns the output to a byte boundary. */
 };
 
 enum
@@ -1026,9 +1222,345 @@ typedef struct e_deflate_decompressor
 
 E_API e_result e_deflate_decompressor_init(e_deflate_decompressor* pDecompressor);
 E_API e_result e_deflate_decompress(e_deflate_decompressor* pDecompressor, const e_uint8* pInputBuffer, size_t* pInputBufferSize, e_uint8* pOutputBufferStart, e_uint8* pOutputBufferNext, size_t* pOutputBufferSize, e_uint32 flags);
+
+/*
+Decompresses an entire deflate stream in a single call.
+
+This is significantly faster than e_deflate_decompress(), but requires the entire compressed stream
+to be in memory, and the output buffer to be large enough to hold all of the decompressed data. Use
+this when the sizes are known ahead of time, such as with Zip entries.
+
+On input, *pInputBufferSize is the size of the input buffer and *pOutputBufferSize is the capacity of
+the output buffer. On output they are set to the number of bytes consumed and written respectively.
+The only supported flag is E_DEFLATE_FLAG_PARSE_ZLIB_HEADER, in which case the Adler-32 checksum is
+also verified.
+
+Returns E_NO_SPACE if the output buffer is too small, E_INVALID_DATA if the data is corrupt or
+truncated, or E_CHECKSUM_MISMATCH if the checksum does not match. The decode tables are allocated
+with the given allocation callbacks.
+*/
+E_API e_result e_deflate_decompress_buffer(const void* pInputBuffer, size_t* pInputBufferSize, void* pOutputBuffer, size_t* pOutputBufferSize, e_uint32 flags, const e_allocation_callbacks* pAllocationCallbacks);
+
+
+/*
+Compression.
+
+The compressor works the same way as the decompressor. Call e_deflate_compress() with as much input
+and output as you have. On output, *pInputBufferSize and *pOutputBufferSize will be set to the number
+of bytes consumed and written. Set E_DEFLATE_FLAG_HAS_MORE_INPUT while there is more input to come.
+When it is not set, the stream is finished off and no more input can be given.
+
+    ```c
+    e_deflate_compressor compressor;
+    e_deflate_compressor_init(&compressor, E_DEFLATE_DEFAULT_LEVEL, E_DEFLATE_FLAG_WRITE_GZIP_HEADER, NULL);
+
+    for (;;) {
+        size_t inputSize  = inputRemaining;
+        size_t outputSize = sizeof(output);
+
+        result = e_deflate_compress(&compressor, pInput, &inputSize, output, &outputSize, 0);
+        pInput         += inputSize;
+        inputRemaining -= inputSize;
+
+        fwrite(output, 1, outputSize, pFile);
+
+        if (result != E_HAS_MORE_OUTPUT) {
+            break;  // Either finished or an error.
+        }
+    }
+
+    e_deflate_compressor_uninit(&compressor);
+    ```
+
+Returns E_HAS_MORE_OUTPUT if the output buffer was filled before all of the input could be
+processed, E_NEEDS_MORE_INPUT if all of the input was consumed and E_DEFLATE_FLAG_HAS_MORE_INPUT was
+set, and E_SUCCESS when the stream has been finished, or when a flush has been completed.
+
+E_DEFLATE_FLAG_FLUSH can be used to force out everything that has been compressed so far, which is
+useful for things like log files where you want the data on disk as soon as possible. Each flush
+costs a few bytes, so don't do it too often.
+
+Levels 1 to 3 use greedy matching and are the fastest. Levels 4 to 9 use lazy matching, searching
+longer hash chains as the level goes up, and are comparable to zlib. Levels 10 to 12 use optimal
+parsing which chooses the cheapest sequence of literals and matches for each chunk of input. These
+are slow but give the best ratio. Level 0 stores the data without compressing it.
+
+The init flags select the framing. With neither E_DEFLATE_FLAG_WRITE_ZLIB_HEADER nor
+E_DEFLATE_FLAG_WRITE_GZIP_HEADER a raw deflate stream is output.
+*/
+#define E_DEFLATE_DEFAULT_LEVEL 6
+#define E_DEFLATE_MAX_LEVEL     12
+
+typedef struct e_deflate_compressor
+{
+    e_uint32 level;
+    e_uint32 flags;                     /* The flags that were passed into e_deflate_compressor_init(). */
+    e_uint32 goodLength;                /* The chain search is cut short when we already have a match of at least this length. */
+    e_uint32 lazyLength;                /* Lazy matching is not attempted when we already have a match of at least this length. For greedy levels this is the longest match to insert into the hash table. */
+    e_uint32 niceLength;                /* Stop searching when a match of at least this length is found. */
+    e_uint32 maxChainLength;
+    e_uint32 passCount;                 /* Optimal parsing only. The number of times each chunk is parsed while refining the cost model. */
+    e_uint32 checksum;                  /* Adler-32 for zlib, CRC-32 for gzip. */
+    e_uint64 totalIn;
+    e_uint8* pWindow;                   /* Twice the size of the sliding window, with the input being compressed sitting at the end. */
+    e_uint16* pHashHead;
+    e_uint16* pHashPrev;
+    e_uint32 strstart;                  /* The position in the window of the next byte to compress. */
+    e_uint32 lookahead;                 /* The number of bytes in the window after strstart. */
+    e_int64 blockStart;                 /* The position in the window of the start of the current block. Can be negative if the window has slid past it. */
+    e_uint32 matchStart;
+    e_uint32 matchLength;
+    e_bool32 matchAvailable;            /* Lazy matching only. Whether or not the byte before strstart is yet to be output. */
+    e_uint32* pSymbols;                 /* The literals and matches making up the current block. */
+    e_uint32 symbolCount;
+    e_uint32 litLenFreqs[288];
+    e_uint32 distFreqs[32];
+    e_uint8 lengthSymbols[256];         /* Maps a match length minus 3 to a length symbol minus 257. */
+    e_uint8 distSymbols[512];           /* Maps a distance minus 1 to a distance symbol. See e_deflate_compressor_dist_symbol(). */
+    e_uint8 costLitLen[288];            /* Optimal parsing only. The estimated cost in bits of each symbol. */
+    e_uint8 costDist[32];
+    e_uint32* pMatches;                 /* Optimal parsing only. */
+    e_uint32* pMatchOffsets;
+    e_uint32* pCosts;
+    e_uint32* pPath;
+    e_uint8* pPending;                  /* Compressed data waiting to be copied into the output buffer. */
+    size_t pendingSize;
+    size_t pendingCursor;
+    e_uint64 bitBuffer;
+    e_uint32 bitCount;
+    e_bool32 isHeaderWritten;
+    e_bool32 isFinished;
+    e_bool32 hasUnflushedInput;
+    e_allocation_callbacks allocationCallbacks;
+} e_deflate_compressor;
+
+E_API e_result e_deflate_compressor_init(e_deflate_compressor* pCompressor, int level, e_uint32 flags, const e_allocation_callbacks* pAllocationCallbacks);
+E_API void e_deflate_compressor_uninit(e_deflate_compressor* pCompressor);
+E_API e_result e_deflate_compress(e_deflate_compressor* pCompressor, const void* pInputBuffer, size_t* pInputBufferSize, void* pOutputBuffer, size_t* pOutputBufferSize, e_uint32 flags);
+E_API size_t e_deflate_compress_bound(size_t inputSize, e_uint32 flags);   /* Returns the largest possible size of the compressed data for an input of the given size, including any framing. */
+
+/*
+Compresses an entire buffer using multiple threads.
+
+The input is split into blocks which are compressed on worker threads, with the 32KB before each
+block used as its dictionary so that very little compression is lost. Each block is ended on a byte
+boundary with an empty stored block, which allows them to be joined together into a single stream.
+The output is a normal deflate stream which can be decompressed with anything, including
+e_deflate_decompress(). This is the same approach as pigz.
+
+Set threadCount to 0 to use one thread per CPU. On input, *pOutputBufferSize is the capacity of the
+output buffer. On output it is the number of bytes written. Use e_deflate_compress_bound() to size
+the output buffer. Returns E_NO_SPACE if the output buffer is too small.
+*/
+E_API e_result e_deflate_compress_parallel(const void* pInputBuffer, size_t inputBufferSize, void* pOutputBuffer, size_t* pOutputBufferSize, int level, e_uint32 flags, e_uint32 threadCount, const e_allocation_callbacks* pAllocationCallbacks);
 /* END e_deflate.h */
 
 
+/* BEG e_inflate_stream.h */
+/*
+An inflate stream wraps another stream containing deflate compressed data and exposes the
+decompressed data through the `e_stream` API. The source stream can be anything - a file, a memory
+stream, a network stream, etc. The source stream is not owned by the inflate stream and must remain
+valid for the life of the inflate stream.
+
+    ```c
+    e_inflate_stream inflateStream;
+    e_inflate_stream_init(pSourceStream, E_INFLATE_FORMAT_AUTO, NULL, &inflateStream);
+
+    e_stream_read(&inflateStream.base, pBuffer, sizeof(pBuffer), &bytesRead);
+
+    e_inflate_stream_uninit(&inflateStream);
+    ```
+
+Three framing formats are supported: raw deflate, zlib (RFC 1950) and gzip (RFC 1952). With
+E_INFLATE_FORMAT_AUTO, the format is detected by looking at the first two bytes of the source
+stream. If neither a gzip nor a zlib header is found, the data is treated as raw deflate. Raw
+deflate data can occasionally look like a zlib header, so if you know the data is raw, specify it
+explicitly.
+
+The checksums of zlib and gzip streams are verified when the end of the compressed data is reached.
+If a checksum does not match, the read will return E_CHECKSUM_MISMATCH. Gzip files made up of
+multiple members are decompressed as a single continuous stream.
+
+Seeking is done by decompressing and discarding data. Seeking backwards beyond the most recently
+decompressed 32KB requires the source stream to be seekable, in which case decompression will
+restart from the beginning. Seeking relative to the end is not supported because the decompressed
+size is not known in advance.
+*/
+typedef enum e_inflate_format
+{
+    E_INFLATE_FORMAT_AUTO = 0,
+    E_INFLATE_FORMAT_RAW,
+    E_INFLATE_FORMAT_ZLIB,
+    E_INFLATE_FORMAT_GZIP
+} e_inflate_format;
+
+typedef struct e_inflate_stream
+{
+    e_stream base;
+    e_stream* pSourceStream;
+    e_int64 sourceOrigin;               /* The position of the source stream at initialization time. Used for restarting when seeking backwards. -1 if the source cannot be repositioned. */
+    e_inflate_format format;            /* Never E_INFLATE_FORMAT_AUTO after initialization. */
+    e_deflate_decompressor decompressor;
+    e_uint64 cursor;                    /* The position in the decompressed data. */
+    e_uint64 memberSize;                /* Gzip only. The number of decompressed bytes in the current member. Used for verifying ISIZE. */
+    e_uint32 crc32;                     /* Gzip only. The running CRC of the current member. */
+    e_bool32 isAtEnd;
+    e_bool32 isSourceAtEnd;
+    e_bool32 isDecompressorDone;        /* Set when the decompressor has finished the current deflate stream. */
+    e_uint8* pCache;                    /* Stores decompressed data. Must be 32KB because it's used as the sliding window. */
+    size_t cacheSize;
+    size_t cacheCursor;
+    e_uint8* pCompressedCache;
+    size_t compressedCacheCap;
+    size_t compressedCacheSize;
+    size_t compressedCacheCursor;
+    e_allocation_callbacks allocationCallbacks;
+} e_inflate_stream;
+
+E_API e_result e_inflate_stream_init(e_stream* pSourceStream, e_inflate_format format, const e_allocation_callbacks* pAllocationCallbacks, e_inflate_stream* pStream);
+E_API void e_inflate_stream_uninit(e_inflate_stream* pStream);
+E_API e_result e_inflate_stream_read(e_inflate_stream* pStream, void* pDst, size_t bytesToRead, size_t* pBytesRead);
+E_API e_result e_inflate_stream_seek(e_inflate_stream* pStream, e_int64 offset, e_seek_origin origin);
+E_API e_result e_inflate_stream_tell(e_inflate_stream* pStream, e_int64* pCursor);
+E_API e_inflate_format e_inflate_stream_get_format(const e_inflate_stream* pStream);
+/* END e_inflate_stream.h */
+
+/* BEG e_lz4.h */
+/*
+LZ4 compression.
+
+LZ4 is much faster than deflate at both compression and decompression at the cost of a lower
+compression ratio. Use it for things like cached derived data, in-memory snapshots and network
+packets where throughput matters more than size.
+
+There are two formats. A block is just the compressed data without any framing. To decompress a
+block you need to know the size of the decompressed data, or at least an upper bound of it, and the
+size of the compressed data. A frame is the standard LZ4 frame format, which is what's used by
+`.lz4` files. It can be decompressed without knowing anything about it in advance and includes
+optional checksums. Frames are compatible with the reference implementation and the lz4 command
+line tool.
+
+    ```c
+    size_t compressedSize = e_lz4_compress_bound(dataSize);
+    void* pCompressedData = e_malloc(compressedSize, NULL);
+
+    e_lz4_compress(pData, dataSize, pCompressedData, &compressedSize, E_LZ4_DEFAULT_LEVEL, NULL);
+
+    // Later on...
+    size_t decompressedSize = dataSize;    // The capacity of pDecompressedData.
+    e_lz4_decompress(pCompressedData, compressedSize, pDecompressedData, &decompressedSize);
+    ```
+
+Levels 1 and 2 use the fast compressor. It uses a 16KB hash table which is placed on the stack so
+no memory is allocated. Levels 3 to 12 use the high compression (HC) compressor, which searches
+more thoroughly for matches. Higher levels compress slower and better. The HC compressor needs
+about 256KB of working memory which will be allocated with the allocation callbacks. Decompression
+speed does not depend on the level, and is usually faster for data compressed with the higher
+levels because there are fewer sequences to decode.
+
+For all functions taking a pDstSize parameter, the value on input is the capacity of the output
+buffer, and on output is the number of bytes written. E_NO_SPACE is returned when the output buffer
+is too small. Corrupt data returns E_INVALID_DATA and a checksum failure in a frame returns
+E_CHECKSUM_MISMATCH. The decompressor will never read or write outside of the given buffers, even
+when the data is corrupt. A single block cannot be larger than E_LZ4_MAX_INPUT_SIZE.
+
+Frames are compressed as a sequence of independent blocks. The frame flags control the block size
+and which checksums are included. The content checksum is recommended for anything that's stored.
+The decompressor supports everything in the frame format except dictionaries, including linked
+blocks and multiple frames joined together.
+
+The compress stream is a write-only `e_stream` which compresses everything written to it as a frame
+and writes it to another stream. The frame is completed by e_lz4_compress_stream_finish(), which
+will also be done by e_lz4_compress_stream_uninit() if it hasn't already been done. The decompress
+stream is a read-only `e_stream` which works the same way as e_inflate_stream, including its
+seeking rules. Neither stream takes ownership of the stream it wraps.
+*/
+#define E_LZ4_DEFAULT_LEVEL     1
+#define E_LZ4_HC_LEVEL          9       /* A good default for the HC compressor. */
+#define E_LZ4_MAX_LEVEL         12
+#define E_LZ4_MAX_INPUT_SIZE    0x7E000000
+
+#define E_LZ4_FLAG_CONTENT_CHECKSUM     0x01    /* Include a checksum of the decompressed data at the end of the frame. */
+#define E_LZ4_FLAG_BLOCK_CHECKSUM       0x02    /* Include a checksum of each block. Allows corruption to be detected before decompressing the block. */
+#define E_LZ4_FLAG_CONTENT_SIZE         0x04    /* Include the decompressed size in the frame header. Ignored by the compress stream because it doesn't know the size up front. */
+#define E_LZ4_FLAG_BLOCK_SIZE_64KB      0x00    /* The default. */
+#define E_LZ4_FLAG_BLOCK_SIZE_256KB     0x10
+#define E_LZ4_FLAG_BLOCK_SIZE_1MB       0x20
+#define E_LZ4_FLAG_BLOCK_SIZE_4MB       0x30
+#define E_LZ4_FLAG_BLOCK_SIZE_MASK      0x30
+
+E_API size_t e_lz4_compress_bound(size_t inputSize);
+E_API e_result e_lz4_compress(const void* pSrc, size_t srcSize, void* pDst, size_t* pDstSize, int level, const e_allocation_callbacks* pAllocationCallbacks);
+E_API e_result e_lz4_decompress(const void* pSrc, size_t srcSize, void* pDst, size_t* pDstSize);
+
+E_API size_t e_lz4_frame_compress_bound(size_t inputSize, e_uint32 flags);
+E_API e_result e_lz4_frame_compress(const void* pSrc, size_t srcSize, void* pDst, size_t* pDstSize, int level, e_uint32 flags, const e_allocation_callbacks* pAllocationCallbacks);
+E_API e_result e_lz4_frame_decompress(const void* pSrc, size_t srcSize, void* pDst, size_t* pDstSize);
+E_API e_result e_lz4_frame_get_content_size(const void* pSrc, size_t srcSize, e_uint64* pContentSize);    /* Returns E_NOT_IMPLEMENTED if the frame header does not include the size. */
+
+
+typedef struct e_lz4_xxh32_state
+{
+    e_uint32 v[4];
+    e_uint64 totalSize;
+    e_uint8 pending[16];
+    size_t pendingSize;
+} e_lz4_xxh32_state;
+
+typedef struct e_lz4_compress_stream
+{
+    e_stream base;
+    e_stream* pDestinationStream;
+    int level;
+    e_uint32 flags;
+    e_uint64 cursor;                    /* The number of uncompressed bytes written. */
+    e_lz4_xxh32_state contentChecksum;
+    e_uint8* pBlock;                    /* Uncompressed data waiting to be compressed. */
+    size_t blockCap;
+    size_t blockSize;
+    e_uint8* pCompressed;               /* Room for a block header, the compressed block and its checksum. */
+    void* pWorkspace;                   /* Hash tables for the compressor. Allocated once and reused for each block. */
+    e_bool32 isHeaderWritten;
+    e_bool32 isFinished;
+    e_allocation_callbacks allocationCallbacks;
+} e_lz4_compress_stream;
+
+E_API e_result e_lz4_compress_stream_init(e_stream* pDestinationStream, int level, e_uint32 flags, const e_allocation_callbacks* pAllocationCallbacks, e_lz4_compress_stream* pStream);
+E_API void e_lz4_compress_stream_uninit(e_lz4_compress_stream* pStream);
+E_API e_result e_lz4_compress_stream_write(e_lz4_compress_stream* pStream, const void* pSrc, size_t bytesToWrite, size_t* pBytesWritten);
+E_API e_result e_lz4_compress_stream_flush(e_lz4_compress_stream* pStream);     /* Compresses and writes any buffered data as a block. Use this to make sure everything written so far can be decompressed by the other end, such as when sending packets. */
+E_API e_result e_lz4_compress_stream_finish(e_lz4_compress_stream* pStream);    /* Writes the end of the frame. Nothing can be written afterwards. */
+
+typedef struct e_lz4_decompress_stream
+{
+    e_stream base;
+    e_stream* pSourceStream;
+    e_int64 sourceOrigin;               /* The position of the source stream at initialization time. Used for restarting when seeking backwards. -1 if the source cannot be repositioned. */
+    e_uint64 cursor;                    /* The position in the decompressed data. */
+    e_uint8 frameFlags;                 /* The FLG byte of the current frame. */
+    size_t blockCap;                    /* The maximum block size of the current frame. */
+    e_lz4_xxh32_state contentChecksum;
+    e_bool32 isAtEnd;
+    e_bool32 isInFrame;
+    e_uint8* pBuffer;                   /* A single allocation for the history, the cache and the compressed block. */
+    size_t bufferBlockCap;              /* The block size pBuffer was allocated for. Only grows. */
+    e_uint8* pCache;                    /* Decompressed data. Linked blocks can refer back to the data before it, which is kept in front of it in pBuffer. */
+    size_t historySize;                 /* The number of bytes before pCache that linked blocks can refer back to. */
+    size_t cacheSize;
+    size_t cacheCursor;
+    e_uint8* pCompressed;
+    e_allocation_callbacks allocationCallbacks;
+} e_lz4_decompress_stream;
+
+E_API e_result e_lz4_decompress_stream_init(e_stream* pSourceStream, const e_allocation_callbacks* pAllocationCallbacks, e_lz4_decompress_stream* pStream);
+E_API void e_lz4_decompress_stream_uninit(e_lz4_decompress_stream* pStream);
+E_API e_result e_lz4_decompress_stream_read(e_lz4_decompress_stream* pStream, void* pDst, size_t bytesToRead, size_t* pBytesRead);
+E_API e_result e_lz4_decompress_stream_seek(e_lz4_decompress_stream* pStream, e_int64 offset, e_seek_origin origin);
+E_API e_result e_lz4_decompress_stream_tell(e_lz4_decompress_stream* pStream, e_int64* pCursor);
+/* END e_lz4.h */
+
+
 
 
 
@@ -1069,6 +1601,9 @@ E_API e_result e_mktmp(const char* pPrefix, char* pTmpPath, size_t tmpPathCap, i
 #define E_ONLY_MOUNTS              0x0100  /* When used, only mounted directories and archives will be considered when opening and iterating files. */
 #define E_NO_SPECIAL_DIRS          0x0200  /* When used, the presence of special directories like "." and ".." will be result in an error when opening files. */
 #define E_NO_ABOVE_ROOT_NAVIGATION 0x0400  /* When used, navigating above the mount point with leading ".." segments will result in an error. Can be also be used with e_path_normalize(). */
+#define E_VERIFY_CHECKSUMS         0x0800  /* When used, backends that store checksums, such as Zip, will verify the data as it's read. A mismatch is reported as E_CHECKSUM_MISMATCH once the end of the file has been read. */
+#define E_NO_SORT                  0x1000  /* Only used with iteration. Entries are returned in the order they were found rather than sorted by name. Duplicates are still removed. */
+#define E_NAMES_ONLY               0x8000  /* Only used with iteration. Only the name and the directory flag of each entry are needed. The rest of the file info may be left zeroed which allows backends to skip a stat() per entry. */
 
 #define E_LOWEST_PRIORITY          0x2000  /* Only used with mounting. When set will create the mount with a lower priority to existing mounts. */
 
@@ -1097,6 +1632,7 @@ typedef struct e_archive_type
 {
     const e_fs_backend* pBackend;
     const char* pExtension;
+    void* pBackendConfig;   /* Passed to the backend when an archive of this type is opened by the e_fs object, such as when it's mounted or opened transparently. Can be NULL. Must remain valid for the lifetime of the e_fs object. */
 } e_archive_type;
 
 struct e_file_info
@@ -1126,12 +1662,41 @@ struct e_fs_config
     e_on_refcount_changed_proc onRefCountChanged;
     void* pRefCountChangedUserData;
     const e_allocation_callbacks* pAllocationCallbacks;
+    e_uint32 asyncThreadCount;  /* The number of I/O threads to use for asynchronous reads. Set to 0 to use the default. Threads are not created until the first asynchronous read is issued. */
+    size_t resolveCacheMemoryLimit; /* The maximum amount of memory to use for the path resolution cache. Set to 0 to disable it. See e_fs_invalidate_resolve_cache(). */
 };
 
 E_API e_fs_config e_config_init_default(void);
 E_API e_fs_config e_fs_config_init(const e_fs_backend* pBackend, void* pBackendConfig, e_stream* pStream);
 
 
+/*
+Standard ioctl operations. Backends can optionally implement these to provide a faster path for
+common operations. A backend should return E_NOT_IMPLEMENTED for any operation it does not support,
+or cannot satisfy in its current state, in which case the generic implementation will be used.
+*/
+#define E_IOCTL_READ_FILE_TO_END    1   /* pArg is a pointer to an e_ioctl_read_file_to_end object. Used by e_file_read_to_end(). */
+
+typedef struct e_ioctl_read_file_to_end
+{
+    e_file* pFile;                  /* The file to read from. Will have been opened with the file system the ioctl is issued against. */
+    e_stream_data_format format;    /* When E_STREAM_DATA_FORMAT_TEXT, the data must be null terminated. */
+    void* pData;                    /* Output. Allocated with the allocation callbacks of the file system. */
+    size_t dataSize;                /* Output. Does not include the null terminator. */
+} e_ioctl_read_file_to_end;
+
+#define E_IOCTL_READ_AT             2   /* pArg is a pointer to an e_ioctl_read_at object. Used by e_file_read_at(). Must be safe to call from multiple threads at once. */
+
+typedef struct e_ioctl_read_at
+{
+    e_file* pFile;                  /* The file to read from. Its cursor must not be used or moved. */
+    e_uint64 offset;                /* The absolute offset to read from. */
+    void* pDst;
+    size_t bytesToRead;
+    size_t bytesRead;               /* Output. */
+} e_ioctl_read_at;
+
+
 typedef struct e_fs_backend
 {
     size_t         (* alloc_size      )(const void* pBackendConfig);
@@ -1153,7 +1718,7 @@ typedef struct e_fs_backend
     e_result       (* file_flush      )(e_file* pFile);
     e_result       (* file_info       )(e_file* pFile, e_file_info* pInfo);
     e_result       (* file_duplicate  )(e_file* pFile, e_file* pDuplicate);                                  /* Duplicate the file handle. */
-    e_fs_iterator* (* first           )(e_fs* pFS, const char* pDirectoryPath, size_t directoryPathLen);
+    e_fs_iterator* (* first           )(e_fs* pFS, const char* pDirectoryPath, size_t directoryPathLen, int mode);   /* mode flags can be ignored by most backends. With E_NAMES_ONLY only the name and the directory flag need to be set. */
     e_fs_iterator* (* next            )(e_fs_iterator* pIterator);  /* <-- Must return null when there are no more files. In this case, free_iterator must be called internally. */
     void           (* free_iterator   )(e_fs_iterator* pIterator);  /* <-- Free the `e_fs_iterator` object here since `first` and `next` were the ones who allocated it. Also do any uninitialization routines. */
 } e_fs_backend;
@@ -1165,6 +1730,7 @@ E_API e_result e_fs_remove(e_fs* pFS, const char* pFilePath); /* Does not consid
 E_API e_result e_fs_rename(e_fs* pFS, const char* pOldName, const char* pNewName);    /* Does not consider mounts. */
 E_API e_result e_fs_mkdir(e_fs* pFS, const char* pPath, int options);  /* Recursive. Will consider mounts unless E_IGNORE_MOUNTS is specified. Returns E_SUCCESS if directory already exists. */
 E_API e_result e_fs_info(e_fs* pFS, const char* pPath, int openMode, e_file_info* pInfo);  /* openMode flags specify same options as openMode in file_open(), but E_READ, E_WRITE, E_TRUNCATE, E_APPEND, and E_OVERWRITE are ignored. */
+E_API e_result e_fs_info_many(e_fs* pFS, const char* const* ppPaths, size_t pathCount, int openMode, e_file_info* pInfos, e_result* pResults);  /* Same as e_fs_info() for each path, with the lookups spread across threads. pResults can be null. Returns E_SUCCESS if every lookup succeeded, otherwise the result of the first path in the list that failed. */
 E_API e_stream* e_fs_get_stream(e_fs* pFS);
 E_API const e_allocation_callbacks* e_fs_get_allocation_callbacks(e_fs* pFS);
 E_API void* e_fs_get_backend_data(e_fs* pFS);    /* For use by the backend. Will be the size returned by the alloc_size() function in the vtable. */
@@ -1180,10 +1746,73 @@ E_API void e_fs_gc_archives(e_fs* pFS, int policy);
 E_API void e_fs_set_archive_gc_threshold(e_fs* pFS, size_t threshold);
 E_API size_t e_fs_get_archive_gc_threshold(e_fs* pFS);
 
+/*
+The resolution cache remembers where files were found when opened for reading, and which files don't
+exist, so that repeated lookups don't need to search every mount point and scan for archives. It's
+disabled by default and enabled with the resolveCacheMemoryLimit config option. Mounting,
+unmounting, writing, removing, renaming and creating directories through the e_fs object will
+invalidate the cache, but changes made outside of the library will not be seen. Call
+e_fs_invalidate_resolve_cache() when that happens, such as in response to a file watcher.
+*/
+typedef struct e_resolve_cache_stats
+{
+    e_uint64 hitCount;
+    e_uint64 missCount;
+    size_t entryCount;
+    size_t memoryUsed;
+    size_t memoryLimit;
+} e_resolve_cache_stats;
+
+E_API void e_fs_invalidate_resolve_cache(e_fs* pFS);
+E_API e_result e_fs_get_resolve_cache_stats(e_fs* pFS, e_resolve_cache_stats* pStats);  /* Everything will be zero if the cache is disabled. */
+
+/*
+The index is a snapshot of every file and directory that can be seen through the read mounts,
+including the contents of archives, with mount priorities already applied. Once it's built, opening
+a file or getting its info for reading is a single hash table lookup. It's intended for when the
+mounts don't change, such as in a shipped game, and should be built after everything has been
+mounted.
+
+Mounting and unmounting discards the index. Anything that's not in the index falls back to a normal
+lookup. Opening a file for writing, e_fs_remove(), e_fs_rename() and e_fs_mkdir() drop the entry
+for the affected path (and everything inside it for removes and renames) so a file written through
+a higher priority mount is seen straight away. Files that are changed from outside of the e_fs are
+not detected and won't take priority over a file that's already in the index until it's rebuilt.
+Paths that name an archive explicitly and lookups in opaque or verbose mode always use a normal
+lookup.
+
+Archives that are referenced by the index are kept open until it's discarded.
+
+The index can be saved with e_fs_save_index() and loaded again with e_fs_load_index() to skip
+building it at startup. Loading fails with E_INVALID_FILE if the mounts are not the same as when it
+was saved, or if an archive has changed. Changes to regular files are not detected, and entries that
+were dropped are saved as they were when the index was built.
+
+e_fs_enumerate_index_shadows() reports every file that's hidden by a file with the same path in a
+higher priority mount or archive.
+*/
+typedef struct e_fs_index_shadow
+{
+    const char* pPath;                  /* The path that's looked up. */
+    const char* pArchivePath;           /* The archive containing the file that is opened, or null if it's a regular file. */
+    const char* pFilePath;              /* The path of the file that is opened, relative to the archive if there is one. */
+    const char* pHiddenArchivePath;     /* The archive containing the file that is hidden, or null if it's a regular file. */
+    const char* pHiddenFilePath;
+} e_fs_index_shadow;
+
+typedef void (* e_fs_index_shadow_proc)(void* pUserData, const e_fs_index_shadow* pShadow);
+
+E_API e_result e_fs_build_index(e_fs* pFS);
+E_API void e_fs_discard_index(e_fs* pFS);
+E_API e_result e_fs_save_index(e_fs* pFS, e_stream* pStream);
+E_API e_result e_fs_load_index(e_fs* pFS, e_stream* pStream);
+E_API e_result e_fs_enumerate_index_shadows(e_fs* pFS, e_fs_index_shadow_proc onShadow, void* pUserData);  /* Returns E_INVALID_OPERATION if there is no index. */
+
 E_API e_result e_file_open(e_fs* pFS, const char* pFilePath, int openMode, e_file** ppFile);
 E_API e_result e_file_open_from_handle(e_fs* pFS, void* hBackendFile, e_file** ppFile);
 E_API void e_file_close(e_file* pFile);
 E_API e_result e_file_read(e_file* pFile, void* pDst, size_t bytesToRead, size_t* pBytesRead); /* Returns 0 on success, E_AT_END on end of file, or an errno result code on error. Will only return E_AT_END if *pBytesRead is 0. */
+E_API e_result e_file_read_at(e_file* pFile, e_uint64 offset, void* pDst, size_t bytesToRead, size_t* pBytesRead);  /* Reads from an absolute offset without moving the cursor. Safe to call from multiple threads at once. Returns E_NOT_IMPLEMENTED if the backend doesn't support it. */
 E_API e_result e_file_write(e_file* pFile, const void* pSrc, size_t bytesToWrite, size_t* pBytesWritten);
 E_API e_result e_file_writef(e_file* pFile, const char* fmt, ...) E_ATTRIBUTE_FORMAT(2, 3);
 E_API e_result e_file_writefv(e_file* pFile, const char* fmt, va_list args);
@@ -1202,6 +1831,58 @@ E_API e_fs_iterator* e_fs_first(e_fs* pFS, const char* pDirectoryPath, int mode)
 E_API e_fs_iterator* e_fs_next(e_fs_iterator* pIterator);
 E_API void e_fs_free_iterator(e_fs_iterator* pIterator);
 
+/*
+Calls onEntry for each file and directory as soon as it's found instead of gathering and sorting
+everything first. Entries are found in the same order as E_NO_SORT and duplicates are removed in the
+same way as e_fs_first(). Return E_FALSE from onEntry to stop early, in which case E_CANCELLED is
+returned.
+*/
+typedef e_bool32 (* e_fs_visit_proc)(void* pUserData, const char* pName, size_t nameLen, const e_file_info* pInfo);
+
+E_API e_result e_fs_visit(e_fs* pFS, const char* pDirectoryPath, int mode, e_fs_visit_proc onEntry, void* pUserData);
+
+/*
+Walks everything under a directory recursively, with subdirectories spread across worker threads.
+Directories are listed the same way as e_fs_first() with the same mode, so mounts are merged and
+archives are descended transparently unless E_OPAQUE or E_VERBOSE is used.
+
+Entries are delivered in batches. The callback is called from the worker threads, but never by more
+than one thread at a time. Return E_FALSE from it to stop the walk, in which case E_CANCELLED is
+returned. Entries are in no particular order. Paths are relative to the root and use "/" as the
+separator.
+
+Patterns are matched against the relative path if they contain a "/", or against the name otherwise.
+"*" matches anything except "/", "**" matches anything including "/" and "?" matches a single
+character other than "/". An entry that matches an exclude pattern is skipped, and if it's a
+directory it's not descended into. If there are any include patterns, only entries that match one of
+them are delivered, but every directory that isn't excluded is still descended into. Patterns are
+tested before any stat() so skipped entries cost nothing beyond being listed.
+*/
+typedef struct e_fs_walk_entry
+{
+    const char* pPath;          /* Relative to the root. Null terminated. */
+    size_t pathLen;
+    const char* pName;          /* Points to the last segment of pPath. */
+    size_t nameLen;
+    e_file_info info;           /* Only the directory flag is set if E_NAMES_ONLY is used. */
+} e_fs_walk_entry;
+
+typedef e_bool32 (* e_fs_walk_proc)(void* pUserData, const e_fs_walk_entry* pEntries, size_t entryCount);
+
+typedef struct e_fs_walk_config
+{
+    int mode;                           /* Iteration mode flags such as E_IGNORE_MOUNTS, E_OPAQUE or E_NAMES_ONLY. */
+    e_uint32 threadCount;               /* Set to 0 to use one thread per CPU. The calling thread is always one of them. */
+    size_t batchSize;                   /* The maximum number of entries per callback. Set to 0 to use the default. */
+    const char* const* ppIncludePatterns;
+    size_t includePatternCount;
+    const char* const* ppExcludePatterns;
+    size_t excludePatternCount;
+} e_fs_walk_config;
+
+E_API e_fs_walk_config e_fs_walk_config_init(void);
+E_API e_result e_fs_walk(e_fs* pFS, const char* pRootPath, const e_fs_walk_config* pConfig, e_fs_walk_proc onEntries, void* pUserData);
+
 E_API e_result e_fs_mount(e_fs* pFS, const char* pActualPath, const char* pVirtualPath, int options);
 E_API e_result e_fs_unmount(e_fs* pFS, const char* pActualPath, int options);
 E_API e_result e_mount_sysdir(e_fs* pFS, e_sysdir_type type, const char* pSubDir, const char* pVirtualPath, int options);
@@ -1227,6 +1908,66 @@ E_API e_result e_file_open_and_read(e_fs* pFS, const char* pFilePath, e_stream_d
 E_API e_result e_file_open_and_write(e_fs* pFS, const char* pFilePath, void* pData, size_t dataSize);
 
 
+/*
+Asynchronous reads.
+
+Asynchronous reads are serviced by a pool of blocking I/O threads. The pool is created the first time
+an asynchronous read is issued against the `e_fs` object. The number of threads can be controlled with
+the `asyncThreadCount` member of `e_fs_config`.
+
+Completion callbacks are never fired from an I/O thread. Instead, completed requests are queued and
+their callbacks are fired from whichever thread calls `e_fs_process_async()`. This lets you choose the
+thread on which your callbacks are fired. The engine will call this at the start of each step, before
+firing onStep, so when using `e_engine` the callbacks will be fired on the main thread:
+
+    void on_read_complete(void* pUserData, e_result result, void* pDst, size_t bytesRead)
+    {
+        ...
+    }
+
+    e_fs_read_async(pFS, "levels/level1.dat", 0, sizeof(buffer), buffer, 0, on_read_complete, NULL, &requestID);
+
+Requests with a higher priority are serviced before those with a lower priority. Requests of equal
+priority are serviced in the order in which they were submitted.
+
+A request can be cancelled with `e_fs_cancel_async()`. If the request has not yet been started it will
+complete with E_CANCELLED without touching the file system. If it has already been started, the read
+will stop at the next chunk boundary and complete with E_CANCELLED. Either way, the callback is always
+fired exactly once.
+
+Use `e_fs_read_async_batch()` to submit multiple requests at once. This is more efficient than calling
+`e_fs_read_async()` multiple times because the queue only needs to be locked once.
+
+The destination buffer must remain valid until the completion callback has been fired. If the end of
+the file is reached before `size` bytes have been read, the request will complete with E_SUCCESS and
+`bytesRead` will be less than the requested size. If the offset is at or beyond the end of the file,
+the request will complete with E_AT_END.
+
+When the `e_fs` object is uninitialized, any outstanding requests are cancelled and their callbacks are
+fired from within `e_fs_uninit()`.
+*/
+typedef void (* e_async_read_proc)(void* pUserData, e_result result, void* pDst, size_t bytesRead);
+
+typedef struct e_async_read
+{
+    const char* pFilePath;      /* Copied internally. */
+    int openMode;               /* Additional open mode flags such as E_OPAQUE or E_IGNORE_MOUNTS. E_READ is always implied. */
+    e_uint64 offset;
+    size_t size;
+    void* pDst;
+    int priority;               /* Higher values are serviced first. */
+    e_async_read_proc onComplete;
+    void* pUserData;
+} e_async_read;
+
+E_API e_async_read e_async_read_init(const char* pFilePath, e_uint64 offset, size_t size, void* pDst, e_async_read_proc onComplete, void* pUserData);
+E_API e_result e_fs_read_async_batch(e_fs* pFS, const e_async_read* pReads, size_t readCount, e_uint64* pRequestIDs);   /* pRequestIDs is optional. If non-null it must have room for readCount items. Either all requests are submitted, or none are. */
+E_API e_result e_fs_read_async(e_fs* pFS, const char* pFilePath, e_uint64 offset, size_t size, void* pDst, int priority, e_async_read_proc onComplete, void* pUserData, e_uint64* pRequestID);
+E_API e_result e_file_read_async(e_file* pFile, e_uint64 offset, size_t size, void* pDst, int priority, e_async_read_proc onComplete, void* pUserData, e_uint64* pRequestID);   /* Does not modify the cursor of pFile. The file can be closed before the request completes. */
+E_API e_result e_fs_cancel_async(e_fs* pFS, e_uint64 requestID);     /* Returns E_DOES_NOT_EXIST if the request has already finished, or if the ID is unknown. */
+E_API size_t e_fs_process_async(e_fs* pFS, size_t maxCompletions);   /* Fires the callbacks of completed requests on the calling thread. Set maxCompletions to 0 to process all completed requests. Returns the number of callbacks that were fired. */
+
+
 /* Default Backend. */
 extern const e_fs_backend* E_FS_STDIO;  /* The default stdio backend. The handle for e_file_open_from_handle() is a FILE*. */
 /* END e_fs.h */
@@ -1266,8 +2007,143 @@ use the Zip backend which you do by passing in E_FS_ZIP, which is declared in th
 well, you'll get a pointer to a new e_fs object representing the Zip archive and you can use it to
 open files from within it just like any other file.
 
-You can pass in NULL for the backend config in e_fs_init().
+You can pass in NULL for the backend config in e_fs_init(), in which case the defaults will be
+used. Otherwise pass in a pointer to an e_zip_config object:
+
+    e_zip_config zipConfig = e_zip_config_init();
+    zipConfig.seekCheckpointInterval = 4 * 1024 * 1024;
+
+    e_fs_config fsConfig = e_fs_config_init(E_FS_ZIP, &zipConfig, e_file_get_stream(pZipArchiveFile));
+    e_fs_init(&fsConfig, &pZip);
+
+Archives that are opened by an e_fs object itself, such as mounted archives and archives that are
+opened transparently, use the backend config of their archive type:
+
+    e_archive_type archiveType;
+    archiveType.pBackend       = E_FS_ZIP;
+    archiveType.pExtension     = "zip";
+    archiveType.pBackendConfig = &zipConfig;
+
+    e_fs_config fsConfig = e_config_init_default();
+    fsConfig.pArchiveTypes    = &archiveType;
+    fsConfig.archiveTypeCount = 1;
+
+The config must remain valid for the lifetime of the e_fs object. Every archive of that type uses
+the same config, but each one applies it separately, so any memory limits are per archive.
+
+Seeking in a compressed file is expensive because everything before the seek point needs to be
+decompressed. To speed this up, once a compressed file has been seeked, checkpoints are recorded at
+regular intervals as it's decompressed. Each one holds the state of the decompressor and the 32KB
+window. A seek will resume decompression from the nearest checkpoint before the seek point rather
+than from the start of the file. Checkpoints are stored with the archive, so they're shared between
+duplicated files, and between files opened separately from the same entry. They're freed when the
+archive is closed.
+
+Each checkpoint costs roughly 43KB. Set seekCheckpointInterval to control how far apart they are
+and seekCheckpointMemoryLimit to control how much memory can be used for them across the whole
+archive. Once the limit has been reached no more checkpoints will be recorded. Set the limit to 0 to
+disable checkpoints entirely. Mounted archives take these settings from the backend config of their
+archive type, so archives of different types can be given different intervals and limits.
+
+Each opened file has a cache for uncompressed data and, for compressed files, a smaller one for the
+compressed data being fed to the decompressor. Set cacheSize and compressedCacheSize to control how
+big these are. Bigger caches mean fewer, larger reads from the archive stream at the cost of more
+memory per opened file. The uncompressed cache doubles as the decompressor's window so it's rounded
+up to a power of two, and to at least 32KB. The memory of the compressed cache is used as part of the
+uncompressed cache for stored files.
+
+Files that are read repeatedly, or by many handles at once, can share their decompressed data
+through an archive-wide block cache. Set blockCacheMemoryLimit to the number of bytes it can use.
+Each block is the size of the uncompressed cache and is added to the block cache when it's
+decompressed. The least recently used blocks are evicted when the limit is reached. A read that can
+be served from the block cache skips decompression entirely, and the decompressor only catches up
+when a block is needed that isn't in it. The block cache is disabled by default.
+
+Cache sizes are set per archive. For mounted archives, and archives opened transparently, they come
+from the backend config of the archive type. Each archive has its own block cache, so the memory limit
+applies to each archive separately rather than to all archives of that type combined.
+
+Opening an archive requires indexing the central directory which can take a while for archives
+with a lot of files. The index can be cached in a sidecar file so that reopening an unchanged
+archive just loads it back in. To enable this, set pIndexCacheDirectory to the directory the index
+files should be stored in. A good place is a subdirectory of the system cache directory:
+
+    char pCacheDir[1024];
+    size_t cacheDirLen = e_sysdir(E_SYSDIR_CACHE, pCacheDir, sizeof(pCacheDir));
+    e_path_append(pCacheDir, sizeof(pCacheDir), pCacheDir, cacheDirLen, "my_app/zip", E_NULL_TERMINATED);
+
+    zipConfig.pIndexCacheDirectory = pCacheDir;
+
+The file name is derived from the size of the archive and the location, size and hash of its
+central directory so a modified archive will never use a stale index. The cache file is written
+when the archive is closed, but only if the index was not loaded from it, or if the directory tree
+was built since (it is built the first time the archive is iterated). Failing to read or write the
+cache is not an error.
+
+The CRC32 of each file can be verified as it's read. Set verifyChecksums to do this for every file
+in the archive, or use the E_VERIFY_CHECKSUMS open mode flag to do it for individual files. The CRC
+is updated incrementally as data is read and checked when the last byte has been read, at which
+point a mismatch will be reported as E_CHECKSUM_MISMATCH. It will continue to be reported from
+subsequent reads at the end of the file. Seeking backwards and rereading data is fine, but if a
+stored (uncompressed) file is seeked forward past data that has not yet been read the file cannot
+be verified and checking is silently disabled for that file. Use a compiler configuration that
+enables hardware CRC32 (see e_crc32()) to keep the cost of this low.
+
+Archives can also be written to. Files are added by opening them in write mode, which requires the
+archive stream to be readable, writable and seekable. To write to an archive file system directly,
+rather than through a mount point, use E_IGNORE_MOUNTS:
+
+    e_file* pArchiveFile;
+    e_file_open(NULL, "archive.zip", E_READ | E_WRITE, &pArchiveFile);   // Use E_READ | E_OVERWRITE to add to an existing archive.
+
+    e_fs_config fsConfig = e_fs_config_init(E_FS_ZIP, NULL, e_file_get_stream(pArchiveFile));
+    e_fs_init(&fsConfig, &pZip);
+
+    e_file_open(pZip, "data/file.txt", E_WRITE | E_IGNORE_MOUNTS, &pFileInsideZip);
+    e_file_write(pFileInsideZip, pData, dataSize, NULL);
+    e_file_close(pFileInsideZip);
+
+    e_fs_uninit(pZip);  // <-- The central directory is written here.
+    e_file_close(pArchiveFile);
+
+An empty stream is treated as an archive with no files. Archives can also be written to through a
+write mount point, in which case the archive will be created if it doesn't exist and it has the
+extension of a registered archive type:
+
+    e_fs_mount(pFS, "build/data.zip", "data", E_WRITE);
+    e_file_open(pFS, "data/file.txt", E_WRITE, &pFile);
+
+The archive is closed when it is unmounted, and the central directory is written once it has been
+garbage collected, or by e_fs_uninit() at the latest. Use E_READ | E_WRITE to mount it for both
+reading and writing.
+
+Only one file can be written at a time, and they must be written sequentially. New entries are
+compressed with deflate using compressionLevel, or stored if it is 0. Set alignment to have the data
+of stored entries aligned to that many bytes from the start of the archive so it can be mapped
+directly. The padding is stored in the extra field of the local header.
+
+Opening an existing file in write mode replaces it. The data of the old entry stays in the archive,
+but is no longer referenced. New entries are written over the top of the old central directory and
+a new one is written when the archive is closed. An archive that is not closed properly after being
+written to will be left without a central directory. Files that have been written can be read
+straight away, but the archive must not be accessed from other threads while writing, and any
+iterators must be freed before a written file is closed.
 */
+typedef struct e_zip_config
+{
+    size_t seekCheckpointInterval;      /* The number of uncompressed bytes between each seek checkpoint. Rounded down to a multiple of the cache size. */
+    size_t seekCheckpointMemoryLimit;   /* The maximum number of bytes to use for seek checkpoints across the entire archive. */
+    const char* pIndexCacheDirectory;   /* The directory to cache the index of the central directory in. Set to NULL (the default) to disable caching. Does not need to exist. */
+    e_bool32 verifyChecksums;           /* When set, the CRC32 of every file opened from the archive is verified as it's read. */
+    int compressionLevel;               /* The deflate level to use for new files. Set to 0 to store new files without compression. Defaults to E_DEFLATE_DEFAULT_LEVEL. */
+    size_t alignment;                   /* The alignment in bytes of the data of new stored files. Set to 0 (the default) for no alignment. Cannot be more than 32768. */
+    size_t cacheSize;                   /* The size in bytes of the uncompressed data cache of each opened file. Rounded up to a power of two, and to at least 32KB. */
+    size_t compressedCacheSize;         /* The size in bytes of the compressed data cache of each opened file. Cannot be less than 1KB. */
+    size_t blockCacheMemoryLimit;       /* The maximum number of bytes of decompressed data to share between files across the entire archive. Set to 0 (the default) to disable. */
+} e_zip_config;
+
+E_API e_zip_config e_zip_config_init(void);
+
 extern const e_fs_backend* E_FS_ZIP;
 /* END e_fs_zip.h */
 
@@ -1310,6 +2186,104 @@ extern const e_fs_backend* E_FS_SUB;
 /* END e_fs_sub.h */
 
 
+/* BEG e_fs_epak.h */
+/*
+Pack file support.
+
+This is a read-only archive format designed for shipping data with an application. Zip is a good
+interchange format, but it's not ideal for loading data at runtime. Local headers have variable
+length so the data is not aligned, and the central directory needs to be indexed before anything
+can be looked up. Pack files fix this:
+
+  - Everything needed to look up files is stored in a single index which is loaded with one read.
+    Nothing is parsed when the pack is opened.
+  - Paths are looked up with a minimal perfect hash that's built when the pack is written, so a
+    lookup is a single probe.
+  - The data of each file is aligned, by default to 4KB, so that stored files can be read straight
+    into the caller's buffer, or mapped directly.
+  - Files can be stored, or compressed with deflate or LZ4. Each file can use a different method.
+  - The CRC32 of each file is stored, and the index itself is protected by a CRC32.
+
+A pack file is used the same way as a Zip file:
+
+    e_fs_config fsConfig = e_fs_config_init(E_FS_EPAK, NULL, e_file_get_stream(pPackFile));
+    e_fs_init(&fsConfig, &pPack);
+
+Pass in a pointer to an e_epak_config object for the backend config to change the defaults. To
+mount pack files like any other archive, register E_FS_EPAK with the "epak" extension in the
+pArchiveTypes list of the file system config.
+
+Packs are created with an e_epak_writer. The stream must be writable and seekable:
+
+    e_epak_writer writer;
+    e_epak_writer_init(e_file_get_stream(pOutputFile), NULL, NULL, &writer);
+
+    e_epak_writer_add(&writer, "data/file.txt", pData, dataSize, E_EPAK_COMPRESSION_DEFLATE);
+    ...
+
+    e_epak_writer_finish(&writer);
+    e_epak_writer_uninit(&writer);
+
+The data of each file is written to the stream as it's added so only the index is held in memory.
+Directories are derived from the paths of the files. If compressing a file would not make it any
+smaller it is stored instead. The index is written by e_epak_writer_finish(). If the same path is
+added twice, or a file has the same path as a directory, it will fail with E_ALREADY_EXISTS.
+
+See tests/e_epak.c for a tool that converts a Zip file or a directory to a pack file.
+*/
+#define E_EPAK_DEFAULT_ALIGNMENT    4096
+
+typedef enum e_epak_compression
+{
+    E_EPAK_COMPRESSION_STORE   = 0,
+    E_EPAK_COMPRESSION_DEFLATE = 1,    /* Raw deflate. */
+    E_EPAK_COMPRESSION_LZ4     = 2     /* A single LZ4 frame. Decompresses much faster than deflate at the expense of a worse ratio. */
+} e_epak_compression;
+
+typedef struct e_epak_config
+{
+    e_bool32 verifyChecksums;           /* When set, the CRC32 of every file opened from the pack is verified as it's read. Otherwise use E_VERIFY_CHECKSUMS to do it for individual files. Checking is disabled for a file if it's seeked forward past unread data. */
+} e_epak_config;
+
+E_API e_epak_config e_epak_config_init(void);
+
+extern const e_fs_backend* E_FS_EPAK;
+
+
+typedef struct e_epak_writer_config
+{
+    size_t alignment;                   /* The alignment in bytes of the data of each file from the start of the pack. Must be a power of two. Defaults to E_EPAK_DEFAULT_ALIGNMENT. */
+    int deflateLevel;                   /* Defaults to E_DEFLATE_DEFAULT_LEVEL. */
+    int lz4Level;                       /* Defaults to E_LZ4_DEFAULT_LEVEL. */
+} e_epak_writer_config;
+
+E_API e_epak_writer_config e_epak_writer_config_init(void);
+
+
+typedef struct e_epak_writer_entry e_epak_writer_entry;
+
+typedef struct e_epak_writer
+{
+    e_stream* pStream;
+    e_epak_writer_config config;
+    e_uint64 cursor;                    /* Where the data of the next file will be written. */
+    e_epak_writer_entry* pEntries;
+    size_t entryCount;
+    size_t entryCap;
+    char* pPaths;                       /* The null terminated path of each entry, one after the other. Becomes the string table. */
+    size_t pathsSize;
+    size_t pathsCap;
+    e_bool32 isFinished;
+    e_allocation_callbacks allocationCallbacks;
+} e_epak_writer;
+
+E_API e_result e_epak_writer_init(e_stream* pStream, const e_epak_writer_config* pConfig, const e_allocation_callbacks* pAllocationCallbacks, e_epak_writer* pWriter);
+E_API void e_epak_writer_uninit(e_epak_writer* pWriter);
+E_API e_result e_epak_writer_add(e_epak_writer* pWriter, const char* pPath, const void* pData, size_t dataSize, e_epak_compression compression);
+E_API e_result e_epak_writer_finish(e_epak_writer* pWriter);
+/* END e_fs_epak.h */
+
+
 /* BEG e_log.h */
 typedef enum
 {
@@ -0,0 +1,1007 @@
+/*
+Headless benchmarks for tracking performance across releases.
+
+A synthetic corpus is generated in a temporary directory before anything is run. It's entirely
+deterministic so the results are comparable between runs and between machines. Each benchmark is
+run a number of times to warm up, and then a number of times while timed. The results are printed
+to stdout as JSON. Anything that goes wrong is printed to stderr.
+
+    e_benchmark [--iterations <count>] [--warmup <count>] [--filter <text>] [--keep-corpus]
+
+Use --filter to only run benchmarks whose name contains the given text. The corpus is deleted when
+the benchmarks are done unless --keep-corpus is specified.
+
+Times are in milliseconds. The throughput is based on the median time and the number of bytes
+processed in each iteration, and is only output for benchmarks where that makes sense.
+*/
+#define E_NO_DEFAULT_LOG_CALLBACK  /* The default callback prints to stdout which is where the JSON goes. */
+#include "../e.c"
+
+#include <stdio.h>
+
+#define E_BENCH_DEFAULT_ITERATIONS      10
+#define E_BENCH_DEFAULT_WARMUP          2
+#define E_BENCH_MAX_ITERATIONS          1000
+
+#define E_BENCH_TEXT_SIZE               (4 * 1024 * 1024)
+#define E_BENCH_DIRECTORY_COUNT         16
+#define E_BENCH_FILES_PER_DIRECTORY     64
+#define E_BENCH_SMALL_FILE_SIZE         4096
+#define E_BENCH_ZIP_ENTRY_COUNT         64
+#define E_BENCH_ZIP_ENTRY_SIZE          (16 * 1024)
+#define E_BENCH_ZIP_LARGE_ENTRY_SIZE    (1024 * 1024)
+#define E_BENCH_SORT_COUNT              8192
+#define E_BENCH_PATH_COUNT              4096
+#define E_BENCH_LOG_COUNT               10000
+#define E_BENCH_CONFIG_SECTION_COUNT    64
+#define E_BENCH_CONFIG_LOOKUP_COUNT     10000
+#define E_BENCH_READ_CHUNK_SIZE         65536
+
+
+typedef struct
+{
+    char corpusPath[1024];
+    e_fs* pFS;
+    e_fs* pZip;
+    e_uint8* pText;             /* The uncompressed corpus text. */
+    size_t textSize;
+    e_uint8* pDeflated;         /* pText compressed as a raw deflate stream. */
+    size_t deflatedSize;
+    e_uint8* pOutput;           /* Scratch space. Big enough to hold pText, or its compressed size. */
+    size_t outputCap;
+    e_uint32* pSortSource;
+    e_uint32* pSortItems;
+    char** ppPaths;
+    char* pPathData;
+    e_log* pLog;
+    e_config_file configFile;
+    e_bool32 isConfigLoaded;
+    e_uint64 sink;              /* Results are accumulated into this so the compiler can't optimize the work away. */
+} e_bench_context;
+
+typedef e_result (* e_bench_proc)(e_bench_context* pContext, e_uint64* pBytesProcessed);
+
+typedef struct
+{
+    const char* pName;
+    e_bench_proc onRun;
+} e_bench;
+
+
+/* Corpus generation. Everything is derived from this so it needs to be stable across platforms. */
+static e_uint32 e_bench_random(e_uint32* pState)
+{
+    e_uint32 x = *pState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *pState = x;
+
+    return x;
+}
+
+static void e_bench_generate_text(e_uint8* pDst, size_t size, e_uint32 seed)
+{
+    static const char* pWords[] =
+    {
+        "the", "of", "and", "to", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by", "on", "not",
+        "engine", "window", "graphics", "surface", "device", "stream", "archive", "file", "directory", "mount", "path", "buffer", "thread", "mutex", "config", "script",
+        "compress", "decompress", "iterate", "normalize", "allocate", "callback", "result", "cursor", "seek", "read", "write", "flush", "close", "open", "info", "size",
+        "0", "1", "2", "16", "32", "64", "128", "256", "1024", "4096", "65536", "error", "warning", "debug", "success", "failure"
+    };
+    size_t cursor = 0;
+    size_t wordsOnLine = 0;
+    e_uint32 state = seed;
+
+    while (cursor < size) {
+        e_uint32 r = e_bench_random(&state);
+        const char* pWord = pWords[r % E_COUNTOF(pWords)];
+        size_t wordLen = strlen(pWord);
+        size_t i;
+
+        for (i = 0; i < wordLen && cursor < size; i += 1) {
+            pDst[cursor++] = (e_uint8)pWord[i];
+        }
+
+        if (cursor < size) {
+            wordsOnLine += 1;
+            if (wordsOnLine > 8 + ((r >> 8) & 7)) {
+                pDst[cursor++] = '\n';
+                wordsOnLine = 0;
+            } else {
+                pDst[cursor++] = ' ';
+            }
+        }
+    }
+}
+
+static e_result e_bench_deflate(const void* pData, size_t dataSize, int level, void** ppCompressed, size_t* pCompressedSize)
+{
+    e_result result;
+    e_deflate_compressor compressor;
+    void* pCompressed;
+    size_t compressedSize;
+    size_t inputSize;
+
+    compressedSize = e_deflate_compress_bound(dataSize, 0);
+    pCompressed = e_malloc(compressedSize, NULL);
+    if (pCompressed == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    result = e_deflate_compressor_init(&compressor, level, 0, NULL);
+    if (result != E_SUCCESS) {
+        e_free(pCompressed, NULL);
+        return result;
+    }
+
+    inputSize = dataSize;
+    result = e_deflate_compress(&compressor, pData, &inputSize, pCompressed, &compressedSize, 0);
+    e_deflate_compressor_uninit(&compressor);
+
+    if (result != E_SUCCESS) {
+        e_free(pCompressed, NULL);
+        return result;
+    }
+
+    *ppCompressed = pCompressed;
+    *pCompressedSize = compressedSize;
+
+    return E_SUCCESS;
+}
+
+static void e_bench_write_le16(e_uint8* pDst, e_uint32 value)
+{
+    pDst[0] = (e_uint8)(value >> 0);
+    pDst[1] = (e_uint8)(value >> 8);
+}
+
+static void e_bench_write_le32(e_uint8* pDst, e_uint32 value)
+{
+    pDst[0] = (e_uint8)(value >>  0);
+    pDst[1] = (e_uint8)(value >>  8);
+    pDst[2] = (e_uint8)(value >> 16);
+    pDst[3] = (e_uint8)(value >> 24);
+}
+
+typedef struct
+{
+    char name[64];
+    e_uint32 method;
+    e_uint32 crc32;
+    e_uint32 compressedSize;
+    e_uint32 uncompressedSize;
+    e_uint32 localHeaderOffset;
+} e_bench_zip_entry;
+
+/*
+There's no Zip writer so the archive is put together by hand. Entries under "stored/" are not
+compressed and entries under "deflated/" are. There's also one large entry of each kind.
+*/
+static e_result e_bench_write_zip(e_bench_context* pContext, const char* pFilePath)
+{
+    e_result result;
+    e_file* pFile;
+    e_bench_zip_entry* pEntries;
+    size_t entryCount = (E_BENCH_ZIP_ENTRY_COUNT + 1) * 2;
+    size_t iEntry;
+    e_uint32 offset = 0;
+    e_uint32 centralDirectoryOffset;
+    e_uint32 centralDirectorySize = 0;
+    e_uint8 header[46];
+
+    pEntries = (e_bench_zip_entry*)e_calloc(sizeof(*pEntries) * entryCount, NULL);
+    if (pEntries == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    result = e_file_open(NULL, pFilePath, E_TRUNCATE, &pFile);
+    if (result != E_SUCCESS) {
+        e_free(pEntries, NULL);
+        return result;
+    }
+
+    for (iEntry = 0; iEntry < entryCount; iEntry += 1) {
+        e_bench_zip_entry* pEntry = &pEntries[iEntry];
+        const e_uint8* pData;
+        size_t dataSize;
+        void* pCompressed = NULL;
+        size_t compressedSize;
+        size_t nameLen;
+        size_t index = iEntry / 2;
+
+        if (index < E_BENCH_ZIP_ENTRY_COUNT) {
+            pData    = pContext->pText + (index * E_BENCH_ZIP_ENTRY_SIZE);
+            dataSize = E_BENCH_ZIP_ENTRY_SIZE;
+            e_snprintf(pEntry->name, sizeof(pEntry->name), "%s/%03u.txt", ((iEntry & 1) == 0) ? "stored" : "deflated", (unsigned int)index);
+        } else {
+            pData    = pContext->pText + (pContext->textSize - E_BENCH_ZIP_LARGE_ENTRY_SIZE);
+            dataSize = E_BENCH_ZIP_LARGE_ENTRY_SIZE;
+            e_snprintf(pEntry->name, sizeof(pEntry->name), "%s/large.txt", ((iEntry & 1) == 0) ? "stored" : "deflated");
+        }
+
+        nameLen = strlen(pEntry->name);
+
+        pEntry->crc32             = e_crc32(0, pData, dataSize);
+        pEntry->uncompressedSize  = (e_uint32)dataSize;
+        pEntry->localHeaderOffset = offset;
+
+        if ((iEntry & 1) == 0) {
+            pEntry->method         = 0;
+            pEntry->compressedSize = (e_uint32)dataSize;
+        } else {
+            result = e_bench_deflate(pData, dataSize, E_DEFLATE_DEFAULT_LEVEL, &pCompressed, &compressedSize);
+            if (result != E_SUCCESS) {
+                break;
+            }
+
+            pEntry->method         = 8;
+            pEntry->compressedSize = (e_uint32)compressedSize;
+            pData                  = (const e_uint8*)pCompressed;
+        }
+
+        E_ZERO_MEMORY(header, sizeof(header));
+        e_bench_write_le32(header +  0, 0x04034b50);
+        e_bench_write_le16(header +  4, 20);
+        e_bench_write_le16(header +  8, pEntry->method);
+        e_bench_write_le32(header + 14, pEntry->crc32);
+        e_bench_write_le32(header + 18, pEntry->compressedSize);
+        e_bench_write_le32(header + 22, pEntry->uncompressedSize);
+        e_bench_write_le16(header + 26, (e_uint32)nameLen);
+
+        result = e_file_write(pFile, header, 30, NULL);
+        if (result == E_SUCCESS) {
+            result = e_file_write(pFile, pEntry->name, nameLen, NULL);
+        }
+        if (result == E_SUCCESS) {
+            result = e_file_write(pFile, pData, pEntry->compressedSize, NULL);
+        }
+
+        e_free(pCompressed, NULL);
+
+        if (result != E_SUCCESS) {
+            break;
+        }
+
+        offset += (e_uint32)(30 + nameLen) + pEntry->compressedSize;
+    }
+
+    centralDirectoryOffset = offset;
+
+    for (iEntry = 0; iEntry < entryCount && result == E_SUCCESS; iEntry += 1) {
+        const e_bench_zip_entry* pEntry = &pEntries[iEntry];
+        size_t nameLen = strlen(pEntry->name);
+
+        E_ZERO_MEMORY(header, sizeof(header));
+        e_bench_write_le32(header +  0, 0x02014b50);
+        e_bench_write_le16(header +  4, 20);
+        e_bench_write_le16(header +  6, 20);
+        e_bench_write_le16(header + 10, pEntry->method);
+        e_bench_write_le32(header + 16, pEntry->crc32);
+        e_bench_write_le32(header + 20, pEntry->compressedSize);
+        e_bench_write_le32(header + 24, pEntry->uncompressedSize);
+        e_bench_write_le16(header + 28, (e_uint32)nameLen);
+        e_bench_write_le32(header + 42, pEntry->localHeaderOffset);
+
+        result = e_file_write(pFile, header, 46, NULL);
+        if (result == E_SUCCESS) {
+            result = e_file_write(pFile, pEntry->name, nameLen, NULL);
+        }
+
+        centralDirectorySize += (e_uint32)(46 + nameLen);
+    }
+
+    if (result == E_SUCCESS) {
+        E_ZERO_MEMORY(header, sizeof(header));
+        e_bench_write_le32(header +  0, 0x06054b50);
+        e_bench_write_le16(header +  8, (e_uint32)entryCount);
+        e_bench_write_le16(header + 10, (e_uint32)entryCount);
+        e_bench_write_le32(header + 12, centralDirectorySize);
+        e_bench_write_le32(header + 16, centralDirectoryOffset);
+
+        result = e_file_write(pFile, header, 22, NULL);
+    }
+
+    e_file_close(pFile);
+    e_free(pEntries, NULL);
+
+    return result;
+}
+
+static e_result e_bench_write_config(const char* pFilePath)
+{
+    e_result result;
+    e_file* pFile;
+    size_t iSection;
+
+    result = e_file_open(NULL, pFilePath, E_TRUNCATE, &pFile);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    for (iSection = 0; iSection < E_BENCH_CONFIG_SECTION_COUNT && result == E_SUCCESS; iSection += 1) {
+        result = e_file_writef(pFile, "section%u =\n{\n    title = \"Section %u\";\n    width = %u;\n    height = %u;\n    size = %u;\n    nested =\n    {\n        value = %u;\n    };\n};\n\n",
+            (unsigned int)iSection, (unsigned int)iSection, (unsigned int)(iSection * 16), (unsigned int)(iSection * 9), (unsigned int)(iSection * 65536), (unsigned int)iSection);
+    }
+
+    e_file_close(pFile);
+
+    return result;
+}
+
+static e_result e_bench_generate_corpus(e_bench_context* pContext)
+{
+    e_result result;
+    char path[1024];
+    size_t iDirectory;
+    size_t iFile;
+    size_t iPath;
+    size_t pathDataCap;
+    size_t pathDataSize = 0;
+    e_uint32 state = 0x12345678;
+    void* pDeflated;
+
+    /* Text. */
+    pContext->textSize = E_BENCH_TEXT_SIZE;
+    pContext->pText = (e_uint8*)e_malloc(pContext->textSize, NULL);
+    if (pContext->pText == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    e_bench_generate_text(pContext->pText, pContext->textSize, 0x9E3779B9);
+
+    result = e_bench_deflate(pContext->pText, pContext->textSize, E_DEFLATE_DEFAULT_LEVEL, &pDeflated, &pContext->deflatedSize);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    pContext->pDeflated = (e_uint8*)pDeflated;
+
+    pContext->outputCap = e_deflate_compress_bound(pContext->textSize, 0);
+    pContext->pOutput = (e_uint8*)e_malloc(pContext->outputCap, NULL);
+    if (pContext->pOutput == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    /* Sorting. */
+    pContext->pSortSource = (e_uint32*)e_malloc(sizeof(e_uint32) * E_BENCH_SORT_COUNT, NULL);
+    pContext->pSortItems  = (e_uint32*)e_malloc(sizeof(e_uint32) * E_BENCH_SORT_COUNT, NULL);
+    if (pContext->pSortSource == NULL || pContext->pSortItems == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    for (iPath = 0; iPath < E_BENCH_SORT_COUNT; iPath += 1) {
+        pContext->pSortSource[iPath] = e_bench_random(&state);
+    }
+
+    /* Paths for normalization. Each has a mix of "." and ".." segments, and doubled up separators. */
+    pathDataCap = E_BENCH_PATH_COUNT * 128;
+    pContext->pPathData = (char*)e_malloc(pathDataCap, NULL);
+    pContext->ppPaths = (char**)e_malloc(sizeof(char*) * E_BENCH_PATH_COUNT, NULL);
+    if (pContext->pPathData == NULL || pContext->ppPaths == NULL) {
+        return E_OUT_OF_MEMORY;
+    }
+
+    for (iPath = 0; iPath < E_BENCH_PATH_COUNT; iPath += 1) {
+        e_uint32 r = e_bench_random(&state);
+        int length;
+
+        length = e_snprintf(pContext->pPathData + pathDataSize, pathDataCap - pathDataSize, "data/%s/level%u/./textures/../models//mesh%u/../../level%u/file%u.%s",
+            ((r & 1) != 0) ? "mods" : "base", (unsigned int)((r >> 1) & 31), (unsigned int)((r >> 6) & 255), (unsigned int)((r >> 14) & 31), (unsigned int)(r >> 19), ((r & 2) != 0) ? "txt" : "bin");
+        if (length < 0) {
+            return E_ERROR;
+        }
+
+        pContext->ppPaths[iPath] = pContext->pPathData + pathDataSize;
+        pathDataSize += (size_t)length + 1;
+    }
+
+    /*
+    Files on disk. These are written without an e_fs object because writing through one requires a
+    write mount point. The e_fs object is only used for reading.
+    */
+    result = e_mktmp("e_benchmark", pContext->corpusPath, sizeof(pContext->corpusPath), E_MKTMP_DIR);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    result = e_fs_init(NULL, &pContext->pFS);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    for (iDirectory = 0; iDirectory < E_BENCH_DIRECTORY_COUNT; iDirectory += 1) {
+        for (iFile = 0; iFile < E_BENCH_FILES_PER_DIRECTORY; iFile += 1) {
+            size_t offset = ((iDirectory * E_BENCH_FILES_PER_DIRECTORY) + iFile) * E_BENCH_SMALL_FILE_SIZE;
+
+            e_snprintf(path, sizeof(path), "%s/files/%02u/%03u.txt", pContext->corpusPath, (unsigned int)iDirectory, (unsigned int)iFile);
+
+            result = e_file_open_and_write(NULL, path, pContext->pText + offset, E_BENCH_SMALL_FILE_SIZE);
+            if (result != E_SUCCESS) {
+                return result;
+            }
+        }
+    }
+
+    e_snprintf(path, sizeof(path), "%s/large.txt", pContext->corpusPath);
+    result = e_file_open_and_write(NULL, path, pContext->pText, pContext->textSize);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    e_snprintf(path, sizeof(path), "%s/archive.zip", pContext->corpusPath);
+    result = e_bench_write_zip(pContext, path);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    e_snprintf(path, sizeof(path), "%s/config.lua", pContext->corpusPath);
+    result = e_bench_write_config(path);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    return E_SUCCESS;
+}
+
+static void e_bench_remove_directory(e_fs* pFS, const char* pDirectoryPath)
+{
+    e_fs_iterator* pIterator;
+    char path[1024];
+
+    for (pIterator = e_fs_first(pFS, pDirectoryPath, E_IGNORE_MOUNTS); pIterator != NULL; pIterator = e_fs_next(pIterator)) {
+        e_snprintf(path, sizeof(path), "%s/%s", pDirectoryPath, pIterator->pName);
+
+        if (pIterator->info.directory) {
+            e_bench_remove_directory(pFS, path);
+        } else {
+            e_fs_remove(pFS, path);
+        }
+    }
+
+    e_fs_remove(pFS, pDirectoryPath);
+}
+
+
+/* Benchmarks. */
+static e_result e_bench_deflate_decompress(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    e_deflate_decompressor decompressor;
+    size_t inputSize  = pContext->deflatedSize;
+    size_t outputSize = pContext->textSize;
+
+    e_deflate_decompressor_init(&decompressor);
+
+    result = e_deflate_decompress(&decompressor, pContext->pDeflated, &inputSize, pContext->pOutput, pContext->pOutput, &outputSize, E_DEFLATE_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    if (outputSize != pContext->textSize) {
+        return E_INVALID_DATA;
+    }
+
+    *pBytesProcessed = outputSize;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_deflate_decompress_buffer(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    size_t inputSize  = pContext->deflatedSize;
+    size_t outputSize = pContext->textSize;
+
+    result = e_deflate_decompress_buffer(pContext->pDeflated, &inputSize, pContext->pOutput, &outputSize, 0, NULL);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    if (outputSize != pContext->textSize) {
+        return E_INVALID_DATA;
+    }
+
+    *pBytesProcessed = outputSize;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_deflate_compress(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    e_deflate_compressor compressor;
+    size_t inputSize  = pContext->textSize;
+    size_t outputSize = pContext->outputCap;
+
+    result = e_deflate_compressor_init(&compressor, E_DEFLATE_DEFAULT_LEVEL, 0, NULL);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    result = e_deflate_compress(&compressor, pContext->pText, &inputSize, pContext->pOutput, &outputSize, 0);
+    e_deflate_compressor_uninit(&compressor);
+
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    pContext->sink += outputSize;
+    *pBytesProcessed = inputSize;
+    return E_SUCCESS;
+}
+
+static int e_bench_compare_uint32(void* pUserData, const void* pA, const void* pB)
+{
+    e_uint32 a = *(const e_uint32*)pA;
+    e_uint32 b = *(const e_uint32*)pB;
+
+    E_UNUSED(pUserData);
+
+    if (a < b) {
+        return -1;
+    } else if (a > b) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+static e_result e_bench_sort_random(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    E_COPY_MEMORY(pContext->pSortItems, pContext->pSortSource, sizeof(e_uint32) * E_BENCH_SORT_COUNT);
+    e_sort(pContext->pSortItems, E_BENCH_SORT_COUNT, sizeof(e_uint32), e_bench_compare_uint32, NULL);
+
+    pContext->sink += pContext->pSortItems[0];
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_sort_sorted(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    /* pSortItems is left sorted by e_bench_sort_random() which is always run first. */
+    e_sort(pContext->pSortItems, E_BENCH_SORT_COUNT, sizeof(e_uint32), e_bench_compare_uint32, NULL);
+
+    pContext->sink += pContext->pSortItems[0];
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_path_normalize(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    char normalized[256];
+    size_t iPath;
+
+    for (iPath = 0; iPath < E_BENCH_PATH_COUNT; iPath += 1) {
+        int length = e_path_normalize(normalized, sizeof(normalized), pContext->ppPaths[iPath], E_NULL_TERMINATED, 0);
+        if (length < 0) {
+            return E_ERROR;
+        }
+
+        pContext->sink += (e_uint64)length;
+    }
+
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_read_file(e_fs* pFS, const char* pFilePath, e_uint8* pBuffer, e_uint64* pBytesRead)
+{
+    e_result result;
+    e_file* pFile;
+
+    result = e_file_open(pFS, pFilePath, E_READ, &pFile);
+    if (result != E_SUCCESS) {
+        return result;
+    }
+
+    for (;;) {
+        size_t bytesRead;
+
+        result = e_file_read(pFile, pBuffer, E_BENCH_READ_CHUNK_SIZE, &bytesRead);
+        if (result != E_SUCCESS) {
+            break;
+        }
+
+        *pBytesRead += bytesRead;
+    }
+
+    e_file_close(pFile);
+
+    if (result != E_AT_END) {
+        return result;
+    }
+
+    return E_SUCCESS;
+}
+
+static e_result e_bench_stdio_read_large(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    char path[1024];
+
+    e_snprintf(path, sizeof(path), "%s/large.txt", pContext->corpusPath);
+
+    *pBytesProcessed = 0;
+    return e_bench_read_file(pContext->pFS, path, pContext->pOutput, pBytesProcessed);
+}
+
+static e_result e_bench_stdio_read_small(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    char path[1024];
+    size_t iDirectory;
+    size_t iFile;
+
+    *pBytesProcessed = 0;
+
+    for (iDirectory = 0; iDirectory < E_BENCH_DIRECTORY_COUNT; iDirectory += 1) {
+        for (iFile = 0; iFile < E_BENCH_FILES_PER_DIRECTORY; iFile += 1) {
+            e_snprintf(path, sizeof(path), "%s/files/%02u/%03u.txt", pContext->corpusPath, (unsigned int)iDirectory, (unsigned int)iFile);
+
+            result = e_bench_read_file(pContext->pFS, path, pContext->pOutput, pBytesProcessed);
+            if (result != E_SUCCESS) {
+                return result;
+            }
+        }
+    }
+
+    return E_SUCCESS;
+}
+
+static e_result e_bench_zip_read_entries(e_bench_context* pContext, const char* pDirectory, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    char path[256];
+    size_t iEntry;
+
+    *pBytesProcessed = 0;
+
+    for (iEntry = 0; iEntry < E_BENCH_ZIP_ENTRY_COUNT; iEntry += 1) {
+        e_snprintf(path, sizeof(path), "%s/%03u.txt", pDirectory, (unsigned int)iEntry);
+
+        result = e_bench_read_file(pContext->pZip, path, pContext->pOutput, pBytesProcessed);
+        if (result != E_SUCCESS) {
+            return result;
+        }
+    }
+
+    return E_SUCCESS;
+}
+
+static e_result e_bench_zip_read_stored(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    return e_bench_zip_read_entries(pContext, "stored", pBytesProcessed);
+}
+
+static e_result e_bench_zip_read_deflated(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    return e_bench_zip_read_entries(pContext, "deflated", pBytesProcessed);
+}
+
+static e_result e_bench_zip_read_stored_large(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    *pBytesProcessed = 0;
+    return e_bench_read_file(pContext->pZip, "stored/large.txt", pContext->pOutput, pBytesProcessed);
+}
+
+static e_result e_bench_zip_read_deflated_large(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    *pBytesProcessed = 0;
+    return e_bench_read_file(pContext->pZip, "deflated/large.txt", pContext->pOutput, pBytesProcessed);
+}
+
+static e_result e_bench_iterate_directory(e_fs* pFS, const char* pDirectoryPath, e_uint64* pCount)
+{
+    e_fs_iterator* pIterator;
+
+    for (pIterator = e_fs_first(pFS, pDirectoryPath, 0); pIterator != NULL; pIterator = e_fs_next(pIterator)) {
+        *pCount += 1;
+    }
+
+    return E_SUCCESS;
+}
+
+static e_result e_bench_stdio_iterate(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    char path[1024];
+    size_t iDirectory;
+    e_uint64 count = 0;
+
+    for (iDirectory = 0; iDirectory < E_BENCH_DIRECTORY_COUNT; iDirectory += 1) {
+        e_snprintf(path, sizeof(path), "%s/files/%02u", pContext->corpusPath, (unsigned int)iDirectory);
+        e_bench_iterate_directory(pContext->pFS, path, &count);
+    }
+
+    if (count != E_BENCH_DIRECTORY_COUNT * E_BENCH_FILES_PER_DIRECTORY) {
+        return E_INVALID_DATA;
+    }
+
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_zip_iterate(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_uint64 count = 0;
+
+    e_bench_iterate_directory(pContext->pZip, "stored",   &count);
+    e_bench_iterate_directory(pContext->pZip, "deflated", &count);
+
+    if (count != (E_BENCH_ZIP_ENTRY_COUNT + 1) * 2) {
+        return E_INVALID_DATA;
+    }
+
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static void e_bench_on_log(void* pUserData, e_log_level level, const char* pMessage)
+{
+    e_bench_context* pContext = (e_bench_context*)pUserData;
+
+    pContext->sink += (e_uint64)level + (e_uint8)pMessage[0];
+}
+
+static e_result e_bench_log_postf(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    size_t iMessage;
+
+    for (iMessage = 0; iMessage < E_BENCH_LOG_COUNT; iMessage += 1) {
+        result = e_log_postf(pContext->pLog, E_LOG_LEVEL_INFO, "Loaded \"%s\" in %.3f ms (%u bytes).", pContext->ppPaths[iMessage % E_BENCH_PATH_COUNT], (double)iMessage * 0.001, (unsigned int)iMessage);
+        if (result != E_SUCCESS) {
+            return result;
+        }
+    }
+
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+static e_result e_bench_config_get(e_bench_context* pContext, e_uint64* pBytesProcessed)
+{
+    e_result result;
+    char section[32];
+    size_t iLookup;
+
+    if (!pContext->isConfigLoaded) {
+        return E_INVALID_OPERATION;
+    }
+
+    for (iLookup = 0; iLookup < E_BENCH_CONFIG_LOOKUP_COUNT; iLookup += 1) {
+        unsigned int iSection = (unsigned int)(iLookup % E_BENCH_CONFIG_SECTION_COUNT);
+        int width;
+        unsigned int height;
+        e_int64 size;
+        e_uint64 value;
+        char* pTitle;
+
+        e_snprintf(section, sizeof(section), "section%u", iSection);
+
+        result = e_config_file_get_int(&pContext->configFile, section, "width", &width);
+        if (result == E_SUCCESS) {
+            result = e_config_file_get_uint(&pContext->configFile, section, "height", &height);
+        }
+        if (result == E_SUCCESS) {
+            result = e_config_file_get_int64(&pContext->configFile, section, "size", &size);
+        }
+        if (result == E_SUCCESS) {
+            result = e_config_file_get_uint64(&pContext->configFile, section, "nested.value", &value);
+        }
+        if (result == E_SUCCESS) {
+            result = e_config_file_get_string(&pContext->configFile, section, "title", NULL, &pTitle);
+        }
+
+        if (result != E_SUCCESS) {
+            return result;
+        }
+
+        pContext->sink += (e_uint64)width + height + (e_uint64)size + value + (e_uint8)pTitle[0];
+        e_free(pTitle, NULL);
+    }
+
+    *pBytesProcessed = 0;
+    return E_SUCCESS;
+}
+
+
+static e_bench g_benchmarks[] =
+{
+    {"deflate_decompress",          e_bench_deflate_decompress},
+    {"deflate_decompress_buffer",   e_bench_deflate_decompress_buffer},
+    {"deflate_compress",            e_bench_deflate_compress},
+    {"sort_random",                 e_bench_sort_random},
+    {"sort_sorted",                 e_bench_sort_sorted},
+    {"path_normalize",              e_bench_path_normalize},
+    {"stdio_read_large",            e_bench_stdio_read_large},
+    {"stdio_read_small",            e_bench_stdio_read_small},
+    {"zip_read_stored",             e_bench_zip_read_stored},
+    {"zip_read_deflated",           e_bench_zip_read_deflated},
+    {"zip_read_stored_large",       e_bench_zip_read_stored_large},
+    {"zip_read_deflated_large",     e_bench_zip_read_deflated_large},
+    {"stdio_iterate",               e_bench_stdio_iterate},
+    {"zip_iterate",                 e_bench_zip_iterate},
+    {"log_postf",                   e_bench_log_postf},
+    {"config_get",                  e_bench_config_get}
+};
+
+
+static int e_bench_compare_double(void* pUserData, const void* pA, const void* pB)
+{
+    double a = *(const double*)pA;
+    double b = *(const double*)pB;
+
+    E_UNUSED(pUserData);
+
+    if (a < b) {
+        return -1;
+    } else if (a > b) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+static e_result e_bench_run(e_bench_context* pContext, const e_bench* pBench, int iterationCount, int warmupCount, e_bool32 isFirst)
+{
+    e_result result = E_SUCCESS;
+    double times[E_BENCH_MAX_ITERATIONS];
+    double total = 0;
+    double median;
+    e_uint64 bytesProcessed = 0;
+    int iIteration;
+
+    for (iIteration = 0; iIteration < warmupCount; iIteration += 1) {
+        result = pBench->onRun(pContext, &bytesProcessed);
+        if (result != E_SUCCESS) {
+            break;
+        }
+    }
+
+    for (iIteration = 0; iIteration < iterationCount && result == E_SUCCESS; iIteration += 1) {
+        e_timer timer;
+
+        e_timer_init(&timer);
+        result = pBench->onRun(pContext, &bytesProcessed);
+        times[iIteration] = e_timer_get_time_in_seconds(&timer) * 1000;
+
+        total += times[iIteration];
+    }
+
+    printf("%s\n    {\"name\": \"%s\", ", (isFirst) ? "" : ",", pBench->pName);
+
+    if (result != E_SUCCESS) {
+        fprintf(stderr, "%s: failed with %s\n", pBench->pName, e_result_description(result));
+        printf("\"error\": \"%s\"}", e_result_description(result));
+        return result;
+    }
+
+    /* Sorting the times makes it easy to get the min, max and median. */
+    e_sort(times, (size_t)iterationCount, sizeof(double), e_bench_compare_double, NULL);
+
+    if ((iterationCount & 1) != 0) {
+        median = times[iterationCount / 2];
+    } else {
+        median = (times[iterationCount / 2 - 1] + times[iterationCount / 2]) / 2;
+    }
+
+    printf("\"iterations\": %d, \"bytes\": %llu, \"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"max_ms\": %.4f", iterationCount, (unsigned long long)bytesProcessed, times[0], median, total / iterationCount, times[iterationCount - 1]);
+
+    if (bytesProcessed > 0 && median > 0) {
+        printf(", \"mb_per_sec\": %.2f", ((double)bytesProcessed / (1024 * 1024)) / (median / 1000));
+    }
+
+    printf("}");
+
+    return E_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    e_result result;
+    e_bench_context context;
+    int iterationCount = E_BENCH_DEFAULT_ITERATIONS;
+    int warmupCount = E_BENCH_DEFAULT_WARMUP;
+    const char* pFilter = NULL;
+    e_bool32 keepCorpus = E_FALSE;
+    e_bool32 isFirst = E_TRUE;
+    int failedCount = 0;
+    int iArg;
+    size_t iBench;
+    char path[1024];
+
+    for (iArg = 1; iArg < argc; iArg += 1) {
+        if (strcmp(argv[iArg], "--iterations") == 0 && iArg + 1 < argc) {
+            iterationCount = atoi(argv[++iArg]);
+        } else if (strcmp(argv[iArg], "--warmup") == 0 && iArg + 1 < argc) {
+            warmupCount = atoi(argv[++iArg]);
+        } else if (strcmp(argv[iArg], "--filter") == 0 && iArg + 1 < argc) {
+            pFilter = argv[++iArg];
+        } else if (strcmp(argv[iArg], "--keep-corpus") == 0) {
+            keepCorpus = E_TRUE;
+        } else {
+            fprintf(stderr, "Usage: %s [--iterations <count>] [--warmup <count>] [--filter <text>] [--keep-corpus]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (iterationCount < 1 || iterationCount > E_BENCH_MAX_ITERATIONS || warmupCount < 0) {
+        fprintf(stderr, "Iteration count must be between 1 and %d.\n", E_BENCH_MAX_ITERATIONS);
+        return 1;
+    }
+
+    E_ZERO_OBJECT(&context);
+
+    result = e_bench_generate_corpus(&context);
+    if (result != E_SUCCESS) {
+        fprintf(stderr, "Failed to generate corpus: %s\n", e_result_description(result));
+        return 1;
+    }
+
+    e_snprintf(path, sizeof(path), "%s/archive.zip", context.corpusPath);
+    result = e_open_archive_ex(context.pFS, E_FS_ZIP, NULL, path, E_NULL_TERMINATED, E_READ, &context.pZip);
+    if (result != E_SUCCESS) {
+        fprintf(stderr, "Failed to open \"%s\": %s\n", path, e_result_description(result));
+    }
+
+    result = e_log_init(NULL, &context.pLog);
+    if (result == E_SUCCESS) {
+        e_log_register_callback(context.pLog, e_bench_on_log, &context, NULL);
+    }
+
+    result = e_config_file_init(NULL, &context.configFile);
+    if (result == E_SUCCESS) {
+        e_snprintf(path, sizeof(path), "%s/config.lua", context.corpusPath);
+        result = e_config_file_load_file(&context.configFile, context.pFS, path, NULL, NULL);
+        if (result == E_SUCCESS) {
+            context.isConfigLoaded = E_TRUE;
+        } else {
+            fprintf(stderr, "Failed to load \"%s\": %s\n", path, e_result_description(result));
+        }
+    }
+
+    printf("{\n  \"version\": \"%d.%d.%d\",\n  \"iterations\": %d,\n  \"warmup\": %d,\n  \"benchmarks\": [", E_VERSION_MAJOR, E_VERSION_MINOR, E_VERSION_PATCH, iterationCount, warmupCount);
+
+    for (iBench = 0; iBench < E_COUNTOF(g_benchmarks); iBench += 1) {
+        if (pFilter != NULL && strstr(g_benchmarks[iBench].pName, pFilter) == NULL) {
+            continue;
+        }
+
+        if (e_bench_run(&context, &g_benchmarks[iBench], iterationCount, warmupCount, isFirst) != E_SUCCESS) {
+            failedCount += 1;
+        }
+
+        isFirst = E_FALSE;
+        fflush(stdout);
+    }
+
+    printf("\n  ]\n}\n");
+
+    /* The sink is output to stderr just so it's used for something. */
+    if (context.sink == 0) {
+        fprintf(stderr, "sink: 0\n");
+    }
+
+    if (context.isConfigLoaded) {
+        e_config_file_uninit(&context.configFile, NULL);
+    }
+
+    e_log_uninit(context.pLog, NULL);
+
+    if (context.pZip != NULL) {
+        e_close_archive(context.pZip);
+    }
+
+    if (!keepCorpus) {
+        e_bench_remove_directory(context.pFS, context.corpusPath);
+    }
+
+    e_fs_uninit(context.pFS);
+    e_free(context.pText, NULL);
+    e_free(context.pDeflated, NULL);
+    e_free(context.pOutput, NULL);
+    e_free(context.pSortSource, NULL);
+    e_free(context.pSortItems, NULL);
+    e_free(context.ppPaths, NULL);
+    e_free(context.pPathData, NULL);
+
+    return (failedCount == 0) ? 0 : 1;
+}
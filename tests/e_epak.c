@@ -0,0 +1,260 @@
+/*
+Converts a Zip file or a directory to a pack file for use with E_FS_EPAK.
+
+    e_epak [--store | --deflate | --lz4] [--alignment <bytes>] <input> <output>
+
+The input is treated as a Zip file if it has a "zip" extension. Otherwise it's treated as a
+directory and everything inside it is added. Files are compressed with deflate by default. Files
+that don't get any smaller are stored regardless. The pack is verified by opening it and reading
+every file back once it has been written.
+*/
+#include "../e.c"
+
+#include <stdio.h>
+
+typedef struct
+{
+    e_epak_writer writer;
+    e_epak_compression compression;
+    size_t fileCount;
+    e_uint64 totalSize;
+} e_epak_context;
+
+static e_result e_epak_add_directory(e_epak_context* pContext, e_fs* pFS, const char* pDirectoryPath, const char* pPackPath)
+{
+    e_result result;
+    e_fs_iterator* pIterator;
+    char path[4096];
+    char packPath[4096];
+
+    for (pIterator = e_fs_first(pFS, pDirectoryPath, E_IGNORE_MOUNTS); pIterator != NULL; pIterator = e_fs_next(pIterator)) {
+        if (pDirectoryPath[0] != '\0') {
+            e_snprintf(path, sizeof(path), "%s/%s", pDirectoryPath, pIterator->pName);
+        } else {
+            e_snprintf(path, sizeof(path), "%s", pIterator->pName);
+        }
+
+        if (pPackPath[0] != '\0') {
+            e_snprintf(packPath, sizeof(packPath), "%s/%s", pPackPath, pIterator->pName);
+        } else {
+            e_snprintf(packPath, sizeof(packPath), "%s", pIterator->pName);
+        }
+
+        if (pIterator->info.directory) {
+            result = e_epak_add_directory(pContext, pFS, path, packPath);
+        } else {
+            e_file* pFile;
+            void* pData;
+            size_t dataSize;
+
+            result = e_file_open(pFS, path, E_READ | E_IGNORE_MOUNTS, &pFile);
+            if (result == E_SUCCESS) {
+                result = e_file_read_to_end(pFile, E_STREAM_DATA_FORMAT_BINARY, &pData, &dataSize);
+                e_file_close(pFile);
+            }
+
+            if (result == E_SUCCESS) {
+                result = e_epak_writer_add(&pContext->writer, packPath, pData, dataSize, pContext->compression);
+                e_free(pData, e_fs_get_allocation_callbacks(pFS));
+
+                pContext->fileCount += 1;
+                pContext->totalSize += dataSize;
+            }
+
+            if (result != E_SUCCESS) {
+                fprintf(stderr, "Failed to add \"%s\": %s\n", path, e_result_description(result));
+            }
+        }
+
+        if (result != E_SUCCESS) {
+            e_fs_free_iterator(pIterator);
+            return result;
+        }
+    }
+
+    return E_SUCCESS;
+}
+
+static e_result e_epak_verify_directory(e_fs* pPack, e_fs* pFS, const char* pDirectoryPath, const char* pPackPath, size_t* pFileCount)
+{
+    e_result result = E_SUCCESS;
+    e_fs_iterator* pIterator;
+    char path[4096];
+    char packPath[4096];
+
+    for (pIterator = e_fs_first(pFS, pDirectoryPath, E_IGNORE_MOUNTS); pIterator != NULL; pIterator = e_fs_next(pIterator)) {
+        if (pDirectoryPath[0] != '\0') {
+            e_snprintf(path, sizeof(path), "%s/%s", pDirectoryPath, pIterator->pName);
+        } else {
+            e_snprintf(path, sizeof(path), "%s", pIterator->pName);
+        }
+
+        if (pPackPath[0] != '\0') {
+            e_snprintf(packPath, sizeof(packPath), "%s/%s", pPackPath, pIterator->pName);
+        } else {
+            e_snprintf(packPath, sizeof(packPath), "%s", pIterator->pName);
+        }
+
+        if (pIterator->info.directory) {
+            result = e_epak_verify_directory(pPack, pFS, path, packPath, pFileCount);
+        } else {
+            e_file* pFile;
+            void* pData;
+            void* pPackData;
+            size_t dataSize;
+            size_t packDataSize;
+
+            result = e_file_open(pFS, path, E_READ | E_IGNORE_MOUNTS, &pFile);
+            if (result == E_SUCCESS) {
+                result = e_file_read_to_end(pFile, E_STREAM_DATA_FORMAT_BINARY, &pData, &dataSize);
+                e_file_close(pFile);
+            }
+
+            if (result == E_SUCCESS) {
+                result = e_file_open(pPack, packPath, E_READ | E_VERIFY_CHECKSUMS, &pFile);
+                if (result == E_SUCCESS) {
+                    result = e_file_read_to_end(pFile, E_STREAM_DATA_FORMAT_BINARY, &pPackData, &packDataSize);
+                    e_file_close(pFile);
+                }
+
+                if (result == E_SUCCESS) {
+                    if (packDataSize != dataSize || memcmp(pData, pPackData, dataSize) != 0) {
+                        result = E_INVALID_FILE;
+                    }
+
+                    e_free(pPackData, e_fs_get_allocation_callbacks(pPack));
+                }
+
+                e_free(pData, e_fs_get_allocation_callbacks(pFS));
+                *pFileCount += 1;
+            }
+
+            if (result != E_SUCCESS) {
+                fprintf(stderr, "Failed to verify \"%s\": %s\n", packPath, e_result_description(result));
+            }
+        }
+
+        if (result != E_SUCCESS) {
+            e_fs_free_iterator(pIterator);
+            return result;
+        }
+    }
+
+    return E_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    e_result result;
+    e_epak_context context;
+    e_epak_writer_config writerConfig;
+    e_fs* pFS;
+    e_fs* pSource = NULL;
+    e_fs* pPack;
+    e_file* pOutputFile;
+    const char* pInputPath = NULL;
+    const char* pOutputPath = NULL;
+    const char* pSourceDirectory;
+    size_t verifiedFileCount = 0;
+    int iArg;
+
+    E_ZERO_OBJECT(&context);
+    context.compression = E_EPAK_COMPRESSION_DEFLATE;
+    writerConfig = e_epak_writer_config_init();
+
+    for (iArg = 1; iArg < argc; iArg += 1) {
+        if (strcmp(argv[iArg], "--store") == 0) {
+            context.compression = E_EPAK_COMPRESSION_STORE;
+        } else if (strcmp(argv[iArg], "--deflate") == 0) {
+            context.compression = E_EPAK_COMPRESSION_DEFLATE;
+        } else if (strcmp(argv[iArg], "--lz4") == 0) {
+            context.compression = E_EPAK_COMPRESSION_LZ4;
+        } else if (strcmp(argv[iArg], "--alignment") == 0 && iArg + 1 < argc) {
+            writerConfig.alignment = (size_t)atoi(argv[++iArg]);
+        } else if (pInputPath == NULL) {
+            pInputPath = argv[iArg];
+        } else if (pOutputPath == NULL) {
+            pOutputPath = argv[iArg];
+        } else {
+            pInputPath = NULL;
+            break;
+        }
+    }
+
+    if (pInputPath == NULL || pOutputPath == NULL) {
+        fprintf(stderr, "Usage: %s [--store | --deflate | --lz4] [--alignment <bytes>] <input> <output>\n", argv[0]);
+        return 1;
+    }
+
+    result = e_fs_init(NULL, &pFS);
+    if (result != E_SUCCESS) {
+        fprintf(stderr, "Failed to initialize file system: %s\n", e_result_description(result));
+        return 1;
+    }
+
+    /* The source is either the Zip file or the directory. */
+    if (e_path_extension_equal(pInputPath, E_NULL_TERMINATED, "zip", E_NULL_TERMINATED)) {
+        result = e_open_archive_ex(pFS, E_FS_ZIP, NULL, pInputPath, E_NULL_TERMINATED, E_READ, &pSource);
+        if (result != E_SUCCESS) {
+            fprintf(stderr, "Failed to open \"%s\": %s\n", pInputPath, e_result_description(result));
+            e_fs_uninit(pFS);
+            return 1;
+        }
+
+        pSourceDirectory = "";
+    } else {
+        pSource = pFS;
+        pSourceDirectory = pInputPath;
+    }
+
+    result = e_file_open(NULL, pOutputPath, E_WRITE | E_TRUNCATE, &pOutputFile);
+    if (result != E_SUCCESS) {
+        fprintf(stderr, "Failed to open \"%s\": %s\n", pOutputPath, e_result_description(result));
+    } else {
+        result = e_epak_writer_init(e_file_get_stream(pOutputFile), &writerConfig, NULL, &context.writer);
+        if (result == E_SUCCESS) {
+            result = e_epak_add_directory(&context, pSource, pSourceDirectory, "");
+            if (result == E_SUCCESS) {
+                result = e_epak_writer_finish(&context.writer);
+                if (result != E_SUCCESS) {
+                    fprintf(stderr, "Failed to write index: %s\n", e_result_description(result));
+                }
+            }
+
+            e_epak_writer_uninit(&context.writer);
+        } else {
+            fprintf(stderr, "Failed to initialize writer: %s\n", e_result_description(result));
+        }
+
+        e_file_close(pOutputFile);
+    }
+
+    /* Read everything back from the pack and compare it against the source. */
+    if (result == E_SUCCESS) {
+        result = e_open_archive_ex(pFS, E_FS_EPAK, NULL, pOutputPath, E_NULL_TERMINATED, E_READ, &pPack);
+        if (result == E_SUCCESS) {
+            result = e_epak_verify_directory(pPack, pSource, pSourceDirectory, "", &verifiedFileCount);
+            e_close_archive(pPack);
+
+            if (result == E_SUCCESS && verifiedFileCount != context.fileCount) {
+                result = E_INVALID_FILE;
+            }
+        }
+
+        if (result != E_SUCCESS) {
+            fprintf(stderr, "Failed to verify \"%s\": %s\n", pOutputPath, e_result_description(result));
+        }
+    }
+
+    if (result == E_SUCCESS) {
+        printf("Wrote %u files (%llu bytes) to \"%s\".\n", (unsigned int)context.fileCount, (unsigned long long)context.totalSize, pOutputPath);
+    }
+
+    if (pSource != pFS) {
+        e_close_archive(pSource);
+    }
+
+    e_fs_uninit(pFS);
+
+    return (result == E_SUCCESS) ? 0 : 1;
+}